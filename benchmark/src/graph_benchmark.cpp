@@ -0,0 +1,654 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "astar.hpp"
+#include "batch_query.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "contraction_hierarchy.hpp"
+#include "csr_dijkstra.hpp"
+#include "delta_stepping.hpp"
+#include "dijkstra.hpp"
+#include "graph_reorder.hpp"
+#include "landmarks.hpp"
+#include "multi_source_dijkstra.hpp"
+#include "synthetic_graphs.hpp"
+
+/*
+ * Shortest-path engines on reproducible synthetic graphs.
+ *
+ * Every benchmark takes two arguments, the graph family (0 = grid, 1 = random, 2 = road) and the node
+ * count, and reports per engine mode:
+ *  - queries: answered queries per second;
+ *  - settled: nodes settled per query;
+ *  - bytes: heap bytes allocated per query, averaged over the run (buffers that only grow on the first
+ *    queries average out towards 0; a per-query allocation shows up as a steady cost);
+ *  - setup_bytes: heap bytes allocated to build the engine, outside the timed loop.
+ * Graphs and query pairs come from fixed seeds, so two runs measure exactly the same work. Compare runs
+ * with the JSON output:
+ *
+ *     graph_benchmark --benchmark_out=results.json --benchmark_out_format=json
+ *
+ * BM_LabelledDijkstra runs the map-based Dijkstra of the examples, whose char labels cap a graph at a few
+ * hundred nodes; it takes the node count only and compares the linear scan with the heap frontiers.
+ */
+
+namespace
+{
+
+std::atomic<std::uint64_t> allocatedBytes{0}; ///< Bytes requested from operator new so far.
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// Replaced together with operator new, so every block goes back through the std::free() matching its std::malloc().
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+
+enum GraphFamily : std::int64_t
+{
+    GRID,
+    RANDOM,
+    ROAD,
+    DENSE ///< Random graph with 32 edges per node, where the vector relaxation kicks in.
+};
+
+constexpr std::uint64_t GRAPH_SEED = 20240601;
+constexpr std::uint64_t QUERY_SEED = 7;
+constexpr std::uint32_t QUERY_COUNT = 256;
+
+/**
+ * @brief One generated graph with everything the engines need, built once per (family, size).
+ */
+struct GraphCase
+{
+    CsrGraph forward;
+    CsrGraph backward;
+    std::vector<Query> queries;
+    std::unique_ptr<ContractionHierarchy> hierarchy; ///< Built on first use.
+    std::unique_ptr<LandmarkTable> landmarks;        ///< Built on first use.
+};
+
+GraphCase &graphCase(std::int64_t family, std::int64_t nodes)
+{
+    static std::map<std::pair<std::int64_t, std::int64_t>, GraphCase> cases;
+    auto found = cases.find({family, nodes});
+    if (found != cases.end())
+    {
+        return found->second;
+    }
+    GraphCase &entry = cases[{family, nodes}];
+    std::uint32_t count = static_cast<std::uint32_t>(nodes);
+    if (family == GRID)
+    {
+        std::uint32_t width = 1;
+        while (width * width < count)
+        {
+            width++;
+        }
+        entry.forward = makeGridGraph(width, count / width, GRAPH_SEED);
+    }
+    else if (family == RANDOM)
+    {
+        entry.forward = makeRandomGraph(count, 4, GRAPH_SEED);
+    }
+    else if (family == DENSE)
+    {
+        entry.forward = makeRandomGraph(count, 32, GRAPH_SEED);
+    }
+    else
+    {
+        entry.forward = makeRoadGraph(count, GRAPH_SEED);
+    }
+    entry.backward = reverseGraph(entry.forward.view());
+    SyntheticRandom random(QUERY_SEED);
+    std::uint32_t nodeCount = entry.forward.nodeCount();
+    for (std::uint32_t i = 0; i < QUERY_COUNT; ++i)
+    {
+        entry.queries.push_back({random.below(nodeCount), random.below(nodeCount)});
+    }
+    return entry;
+}
+
+const ContractionHierarchy &hierarchyOf(GraphCase &entry)
+{
+    if (!entry.hierarchy)
+    {
+        entry.hierarchy.reset(new ContractionHierarchy(ContractionHierarchy::build(entry.forward.view())));
+    }
+    return *entry.hierarchy;
+}
+
+const LandmarkTable &landmarksOf(GraphCase &entry)
+{
+    if (!entry.landmarks)
+    {
+        entry.landmarks.reset(new LandmarkTable(LandmarkTable::build(entry.forward.view())));
+    }
+    return *entry.landmarks;
+}
+
+const char *familyName(std::int64_t family)
+{
+    static const char *const NAMES[] = {"grid", "random", "road", "dense"};
+    return NAMES[family];
+}
+
+/**
+ * @brief Runs query(source, target) over the fixed query pairs and fills in the counters.
+ *
+ * @param query Answers one query and returns the number of nodes it settled.
+ */
+template <typename Run>
+void measure(benchmark::State &state, const GraphCase &entry, std::uint64_t setupBytes, Run query)
+{
+    std::uint64_t settled = 0;
+    std::size_t next = 0;
+    std::uint64_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        const Query &q = entry.queries[next];
+        next = next + 1 == entry.queries.size() ? 0 : next + 1;
+        settled += query(q.source, q.target);
+    }
+    std::uint64_t bytes = allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+    state.SetLabel(familyName(state.range(0)));
+    state.counters["queries"] = benchmark::Counter(double(state.iterations()), benchmark::Counter::kIsRate);
+    state.counters["settled"] = benchmark::Counter(double(settled), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"] = benchmark::Counter(double(bytes), benchmark::Counter::kAvgIterations);
+    state.counters["setup_bytes"] = double(setupBytes);
+}
+
+/**
+ * @brief Allocations made while constructing an engine.
+ */
+template <typename Make>
+auto constructCounted(std::uint64_t &bytes, Make make)
+{
+    std::uint64_t before = allocatedBytes.load(std::memory_order_relaxed);
+    auto engine = make();
+    bytes = allocatedBytes.load(std::memory_order_relaxed) - before;
+    return engine;
+}
+
+template <typename Frontier>
+void BM_CsrDijkstra(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<CsrDijkstra<Frontier>>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source, target);
+                benchmark::DoNotOptimize(engine->distance(target));
+                return engine->settledCount();
+            });
+}
+
+void BM_CsrDijkstraWithPath(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<CsrDijkstra<>>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source, target);
+                std::vector<std::uint32_t> path = engine->path(target);
+                benchmark::DoNotOptimize(path.data());
+                return engine->settledCount();
+            });
+}
+
+void BM_CsrDijkstraPathInto(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<CsrDijkstra<>>(entry.forward.view()); });
+    std::vector<std::uint32_t> path(entry.forward.nodeCount());
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source, target);
+                benchmark::DoNotOptimize(engine->pathInto(target, path.data(), path.size()));
+                return engine->settledCount();
+            });
+}
+
+/**
+ * @brief CsrDijkstra on the graph renumbered for locality, queried with the original ids.
+ */
+template <NodeOrder Order>
+void BM_Reordered(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    if (Order == NodeOrder::Hilbert && entry.forward.coordinates.empty())
+    {
+        state.SkipWithError("graph has no coordinates");
+        return;
+    }
+    ReorderedGraph reordered = reorderGraph(entry.forward, Order);
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<RenumberedSearch<>>(reordered); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source, target);
+                benchmark::DoNotOptimize(engine->distance(target));
+                return engine->settledCount();
+            });
+}
+
+void BM_DistanceOnly(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<DistanceOnlyDijkstra<>>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source, target);
+                benchmark::DoNotOptimize(engine->distance(target));
+                return engine->settledCount();
+            });
+}
+
+/**
+ * @brief Full trees with the relaxation kernel forced to one instruction set (same results at every level).
+ */
+template <SimdLevel Level>
+void BM_Relaxation(benchmark::State &state)
+{
+    if (Level > detectSimdLevel())
+    {
+        state.SkipWithError("instruction set not supported by this CPU");
+        return;
+    }
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<DistanceOnlyDijkstra<>>(entry.forward.view()); });
+    engine->setSimdLevel(Level);
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t)
+            {
+                engine->run(source);
+                return engine->settledCount();
+            });
+}
+
+/**
+ * @brief Service area of a fixed budget per family (about a thousand nodes): the cost per query should
+ *        stay flat as the graph grows, since only the ball is touched.
+ */
+void BM_Isochrone(benchmark::State &state)
+{
+    static const float BUDGETS[] = {100.0f, 150.0f, 20.0f};
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    const float budget = BUDGETS[state.range(0)];
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<CsrDijkstra<>>(entry.forward.view()); });
+    std::vector<ReachedNode> ball;
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t)
+            {
+                std::uint32_t settled = engine->runWithin(source, budget, ball);
+                benchmark::DoNotOptimize(ball.data());
+                return settled;
+            });
+}
+
+void BM_Bidirectional(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<BidirectionalDijkstra<>>(entry.forward.view(),
+                                                                                       entry.backward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                benchmark::DoNotOptimize(engine->run(source, target));
+                return engine->settledCount();
+            });
+}
+
+void BM_AStarEuclidean(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    CsrView view = entry.forward.view();
+    if (view.coordinates == nullptr)
+    {
+        state.SkipWithError("graph has no coordinates");
+        return;
+    }
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<AStar<EuclideanHeuristic>>(
+                                         view, EuclideanHeuristic(view.coordinates)); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                benchmark::DoNotOptimize(engine->run(source, target));
+                return engine->settledCount();
+            });
+}
+
+void BM_AStarLandmarks(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    const LandmarkTable &landmarks = landmarksOf(entry);
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<AStar<LandmarkHeuristic>>(
+                                         entry.forward.view(), LandmarkHeuristic(landmarks)); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                benchmark::DoNotOptimize(engine->run(source, target));
+                return engine->settledCount();
+            });
+}
+
+void BM_ContractionHierarchy(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    const ContractionHierarchy &hierarchy = hierarchyOf(entry);
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<HierarchyQuery<>>(hierarchy); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                benchmark::DoNotOptimize(engine->run(source, target));
+                return engine->settledCount();
+            });
+}
+
+void BM_DijkstraTree(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<CsrDijkstra<>>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source);
+                benchmark::DoNotOptimize(engine->distance(target));
+                return engine->settledCount();
+            });
+}
+
+void BM_DeltaSteppingTree(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<DeltaStepping>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t source, std::uint32_t target)
+            {
+                engine->run(source);
+                benchmark::DoNotOptimize(engine->distance(target));
+                return engine->reachedCount();
+            });
+}
+
+void BM_NearestSource(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::vector<std::uint32_t> sources;
+    for (const Query &query : entry.queries)
+    {
+        sources.push_back(query.source);
+    }
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&]
+                                   { return std::make_unique<MultiSourceDijkstra<>>(entry.forward.view()); });
+    measure(state, entry, setup,
+            [&](std::uint32_t, std::uint32_t target)
+            {
+                engine->run(sources);
+                benchmark::DoNotOptimize(engine->nearestSource(target));
+                return engine->settledCount();
+            });
+}
+
+void BM_BatchQueries(benchmark::State &state)
+{
+    GraphCase &entry = graphCase(state.range(0), state.range(1));
+    std::uint64_t setup;
+    auto engine = constructCounted(setup, [&] { return std::make_unique<BatchQueryEngine<>>(entry.forward.view()); });
+    std::vector<QueryResult> results;
+    std::uint64_t settled = 0;
+    std::uint64_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        engine->answer(entry.queries, results, false);
+        for (const QueryResult &result : results)
+        {
+            settled += result.settled;
+        }
+    }
+    std::uint64_t bytes = allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+    double queries = double(state.iterations()) * double(entry.queries.size());
+    state.SetLabel(familyName(state.range(0)));
+    state.counters["queries"] = benchmark::Counter(queries, benchmark::Counter::kIsRate);
+    state.counters["settled"] = double(settled) / queries;
+    state.counters["bytes"] = double(bytes) / queries;
+    state.counters["setup_bytes"] = double(setup);
+}
+
+constexpr char FIRST_LABEL = '!'; ///< ' ' means "no node" to the map-based engine, so labels start after it.
+
+/**
+ * @brief Labelled graph for the map-based Dijkstra: a ring plus three random edges per node, weights in [1, 10].
+ *
+ * The weights are whole numbers so the same graph serves the float and the integer engines.
+ */
+template <typename Weight>
+const typename Dijkstra<LinearScan, NoTrace, Weight>::GraphType &labelledGraph(std::int64_t nodes)
+{
+    static std::map<std::int64_t, typename Dijkstra<LinearScan, NoTrace, Weight>::GraphType> graphs;
+    auto found = graphs.find(nodes);
+    if (found != graphs.end())
+    {
+        return found->second;
+    }
+    auto &graph = graphs[nodes];
+    SyntheticRandom random(GRAPH_SEED);
+    std::uint32_t count = static_cast<std::uint32_t>(nodes);
+    auto label = [](std::uint32_t node) { return static_cast<char>(FIRST_LABEL + node); };
+    auto weight = [&]() { return static_cast<Weight>(1 + random.below(10)); };
+    for (std::uint32_t node = 0; node < count; ++node)
+    {
+        auto &edges = graph[label(node)];
+        edges.push_back({label((node + 1) % count), weight()});
+        for (int extra = 0; extra < 3; ++extra)
+        {
+            edges.push_back({label(random.below(count)), weight()});
+        }
+    }
+    return graph;
+}
+
+/**
+ * @brief Map-based Dijkstra with one frontier, from the fixed query pairs.
+ *
+ * Building the engine copies the graph, so that part runs with the timer paused; the search, the path
+ * reconstruction and the (discarded) path printing are timed.
+ */
+template <typename Frontier, typename Weight = float>
+void BM_LabelledDijkstra(benchmark::State &state)
+{
+    using Engine = Dijkstra<Frontier, CountingTrace, Weight>;
+    const auto &graph = labelledGraph<Weight>(state.range(0));
+    std::uint32_t count = static_cast<std::uint32_t>(state.range(0));
+    std::vector<std::pair<char, char>> queries;
+    SyntheticRandom random(QUERY_SEED);
+    for (std::uint32_t i = 0; i < QUERY_COUNT; ++i)
+    {
+        queries.emplace_back(static_cast<char>(FIRST_LABEL + random.below(count)),
+                             static_cast<char>(FIRST_LABEL + random.below(count)));
+    }
+    std::optional<Engine> engine;
+    std::uint64_t settled = 0;
+    std::uint64_t bytes = 0;
+    std::size_t next = 0;
+    std::cout.setstate(std::ios::badbit); // calculateDistances() prints the path.
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        engine.emplace(typename Engine::PointType(queries[next].first, 0),
+                       typename Engine::PointType(queries[next].second, 0), graph);
+        next = next + 1 == queries.size() ? 0 : next + 1;
+        state.ResumeTiming();
+        std::uint64_t before = allocatedBytes.load(std::memory_order_relaxed);
+        engine->initializeDistances();
+        engine->calculateDistances();
+        bytes += allocatedBytes.load(std::memory_order_relaxed) - before;
+        settled += engine->tracer().iterations;
+    }
+    std::cout.clear();
+    state.SetLabel("labelled");
+    state.counters["queries"] = benchmark::Counter(double(state.iterations()), benchmark::Counter::kIsRate);
+    state.counters["settled"] = benchmark::Counter(double(settled), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"] = benchmark::Counter(double(bytes), benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief Node counts the char labels allow.
+ */
+void labelledGraphs(benchmark::internal::Benchmark *b)
+{
+    b->ArgNames({"nodes"});
+    for (std::int64_t nodes : {32, 200})
+    {
+        b->Args({nodes});
+    }
+}
+
+/**
+ * @brief Every graph family at every size.
+ */
+void allGraphs(benchmark::internal::Benchmark *b)
+{
+    b->ArgNames({"graph", "nodes"});
+    for (std::int64_t family : {GRID, RANDOM, ROAD})
+    {
+        for (std::int64_t nodes : {1 << 10, 1 << 14, 1 << 17})
+        {
+            b->Args({family, nodes});
+        }
+    }
+}
+
+/**
+ * @brief Graphs with coordinates only.
+ */
+void geometricGraphs(benchmark::internal::Benchmark *b)
+{
+    b->ArgNames({"graph", "nodes"});
+    for (std::int64_t family : {GRID, ROAD})
+    {
+        for (std::int64_t nodes : {1 << 10, 1 << 14, 1 << 17})
+        {
+            b->Args({family, nodes});
+        }
+    }
+}
+
+/**
+ * @brief Random graphs of low and high degree, to compare the relaxation kernels.
+ */
+void denseGraphs(benchmark::internal::Benchmark *b)
+{
+    b->ArgNames({"graph", "nodes"});
+    for (std::int64_t family : {RANDOM, DENSE})
+    {
+        for (std::int64_t nodes : {1 << 14, 1 << 17})
+        {
+            b->Args({family, nodes});
+        }
+    }
+}
+
+/**
+ * @brief Contraction is slow on random graphs (they have no small separators): keep those small.
+ */
+void hierarchyGraphs(benchmark::internal::Benchmark *b)
+{
+    geometricGraphs(b);
+    b->Args({RANDOM, 1 << 10});
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_LabelledDijkstra, LinearScan)->Apply(labelledGraphs);
+BENCHMARK_TEMPLATE(BM_LabelledDijkstra, BinaryHeap)->Apply(labelledGraphs);
+BENCHMARK_TEMPLATE(BM_LabelledDijkstra, QuaternaryHeap)->Apply(labelledGraphs);
+BENCHMARK_TEMPLATE(BM_LabelledDijkstra, LazyHeap)->Apply(labelledGraphs);
+BENCHMARK_TEMPLATE2(BM_LabelledDijkstra, LinearScan, std::uint16_t)->Apply(labelledGraphs);
+BENCHMARK_TEMPLATE2(BM_LabelledDijkstra, AutoFrontier, std::uint16_t)->Apply(labelledGraphs); // BucketQueue
+BENCHMARK_TEMPLATE(BM_CsrDijkstra, BinaryHeap)->Apply(allGraphs);
+BENCHMARK_TEMPLATE(BM_CsrDijkstra, QuaternaryHeap)->Apply(allGraphs);
+BENCHMARK_TEMPLATE(BM_CsrDijkstra, LazyHeap)->Apply(allGraphs);
+BENCHMARK(BM_CsrDijkstraWithPath)->Apply(allGraphs);
+BENCHMARK(BM_CsrDijkstraPathInto)->Apply(allGraphs);
+BENCHMARK(BM_DistanceOnly)->Apply(allGraphs);
+BENCHMARK_TEMPLATE(BM_Reordered, NodeOrder::Bfs)->Apply(allGraphs);
+BENCHMARK_TEMPLATE(BM_Reordered, NodeOrder::ReverseCuthillMcKee)->Apply(allGraphs);
+BENCHMARK_TEMPLATE(BM_Reordered, NodeOrder::Hilbert)->Apply(geometricGraphs);
+BENCHMARK_TEMPLATE(BM_Relaxation, SimdLevel::Scalar)->Apply(denseGraphs);
+BENCHMARK_TEMPLATE(BM_Relaxation, SimdLevel::Avx2)->Apply(denseGraphs);
+BENCHMARK_TEMPLATE(BM_Relaxation, SimdLevel::Avx512)->Apply(denseGraphs);
+BENCHMARK(BM_Isochrone)->Apply(allGraphs);
+BENCHMARK(BM_Bidirectional)->Apply(allGraphs);
+BENCHMARK(BM_AStarEuclidean)->Apply(geometricGraphs);
+BENCHMARK(BM_AStarLandmarks)->Apply(allGraphs);
+BENCHMARK(BM_ContractionHierarchy)->Apply(hierarchyGraphs);
+BENCHMARK(BM_DijkstraTree)->Apply(allGraphs);
+BENCHMARK(BM_DeltaSteppingTree)->Apply(allGraphs);
+BENCHMARK(BM_NearestSource)->Apply(allGraphs);
+BENCHMARK(BM_BatchQueries)->Apply(allGraphs)->UseRealTime();
+
+BENCHMARK_MAIN();
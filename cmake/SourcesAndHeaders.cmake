@@ -1,16 +1,66 @@
+# The engines are header-only: there is nothing to compile into the library itself.
 set(sources
-    src/tmp.cpp
-)
-
-set(exe_sources
-		src/main.cpp
-		${sources}
 )
 
 set(headers
-    include/project/tmp.hpp
+    "src/Module 3/all_pairs.hpp"
+    "src/Module 3/astar.hpp"
+    "src/Module 3/batch_query.hpp"
+    "src/Module 3/bidirectional_dijkstra.hpp"
+    "src/Module 3/contraction_hierarchy.hpp"
+    "src/Module 3/csr_dijkstra.hpp"
+    "src/Module 3/csr_graph.hpp"
+    "src/Module 3/delta_stepping.hpp"
+    "src/Module 3/dijkstra.hpp"
+    "src/Module 3/dynamic_sssp.hpp"
+    "src/Module 3/edge_list_parser.hpp"
+    "src/Module 3/graph_file.hpp"
+    "src/Module 3/graph_reorder.hpp"
+    "src/Module 3/indexed_heap.hpp"
+    "src/Module 3/landmarks.hpp"
+    "src/Module 3/multi_source_dijkstra.hpp"
+    "src/Module 3/parallel.hpp"
+    "src/Module 3/path_cache.hpp"
+    "src/Module 3/query_context.hpp"
+    "src/Module 3/query_server.hpp"
+    "src/Module 3/relax_kernels.hpp"
+    "src/Module 3/simd.hpp"
+    "src/Module 3/static_graph.hpp"
+    "src/Module 3/synthetic_graphs.hpp"
+    "src/Module 3/synthetic_random.hpp"
+    "src/Module 3/tracing.hpp"
 )
 
 set(test_sources
-  src/tmp_test.cpp
+  src/all_pairs_test.cpp
+  src/astar_test.cpp
+  src/batch_query_test.cpp
+  src/bidirectional_dijkstra_test.cpp
+  src/contraction_hierarchy_test.cpp
+  src/csr_dijkstra_test.cpp
+  src/delta_stepping_test.cpp
+  src/dijkstra_test.cpp
+  src/dynamic_sssp_test.cpp
+  src/edge_list_parser_test.cpp
+  src/graph_file_test.cpp
+  src/graph_reorder_test.cpp
+  src/isochrone_test.cpp
+  src/landmarks_test.cpp
+  src/multi_source_dijkstra_test.cpp
+  src/parallel_test.cpp
+  src/path_cache_test.cpp
+  src/query_context_test.cpp
+  src/query_server_test.cpp
+  src/relax_kernels_test.cpp
+  src/static_graph_test.cpp
+  src/tracing_test.cpp
+  src/weight_types_test.cpp
+)
+
+set(benchmark_sources
+  src/graph_benchmark.cpp
+)
+
+set(python_sources
+  src/shortest_paths.cpp
 )
@@ -3,7 +3,7 @@
 #
 
 option(${PROJECT_NAME}_BUILD_EXECUTABLE "Build the project as an executable, rather than a library." OFF)
-option(${PROJECT_NAME}_BUILD_HEADERS_ONLY "Build the project as a header-only library." OFF)
+option(${PROJECT_NAME}_BUILD_HEADERS_ONLY "Build the project as a header-only library." ON)
 option(${PROJECT_NAME}_USE_ALT_NAMES "Use alternative names for the project, such as naming the include directory all lowercase." ON)
 
 #
@@ -32,6 +32,20 @@ option(${PROJECT_NAME}_USE_GOOGLE_MOCK "Use the GoogleMock project for extending
 
 option(${PROJECT_NAME}_USE_CATCH2 "Use the Catch2 project for creating unit tests." OFF)
 
+#
+# Benchmarks
+#
+# Currently supporting: Google Benchmark.
+
+option(${PROJECT_NAME}_ENABLE_BENCHMARKS "Build the benchmarks (from the `benchmark` subfolder)." OFF)
+
+#
+# Python bindings
+#
+# Currently supporting: pybind11.
+
+option(${PROJECT_NAME}_ENABLE_PYTHON "Build the Python module (from the `python` subfolder)." OFF)
+
 #
 # Static analyzers
 #
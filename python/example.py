@@ -0,0 +1,71 @@
+"""
+Compares the C++ engine (module shortest_paths) with the pure Python dijkstra() of Module 3.
+
+    make python
+    PYTHONPATH=build/python python3 python/example.py
+"""
+import contextlib
+import io
+import math
+import os
+import sys
+import time
+
+import numpy as np
+
+import shortest_paths as sp
+
+# algoritmo_dijkstra.py prints its own example when imported; keep that out of this output.
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "src", "Module 3"))
+with contextlib.redirect_stdout(io.StringIO()):
+    from algoritmo_dijkstra import dijkstra
+
+
+def random_graph(node_count, edge_count, seed=1):
+    rng = np.random.default_rng(seed)
+    sources = rng.integers(0, node_count, edge_count, dtype=np.uint32)
+    targets = rng.integers(0, node_count, edge_count, dtype=np.uint32)
+    weights = rng.uniform(1.0, 100.0, edge_count).astype(np.float32)
+    return sources, targets, weights
+
+
+def main():
+    node_count, edge_count = 20000, 100000
+    sources, targets, weights = random_graph(node_count, edge_count)
+
+    graph = sp.Graph(node_count, sources, targets, weights)
+    adjacency = {node: [] for node in range(node_count)}
+    for u, v, w in zip(sources.tolist(), targets.tolist(), weights.tolist()):
+        adjacency[u].append((v, w))
+
+    start = time.perf_counter()
+    expected = dijkstra(adjacency, 0)
+    python_seconds = time.perf_counter() - start
+
+    engine = sp.Engine(graph)
+    start = time.perf_counter()
+    row = engine.distances(0)
+    cpp_seconds = time.perf_counter() - start
+
+    for node in range(node_count):
+        if math.isinf(expected[node]):
+            assert math.isinf(row[node])
+        else:
+            assert math.isclose(row[node], expected[node], rel_tol=1e-4)
+    print(f"one source, {node_count} nodes: python {python_seconds * 1e3:.1f} ms, C++ {cpp_seconds * 1e3:.2f} ms")
+
+    batch = sp.BatchEngine(graph)
+    rng = np.random.default_rng(2)
+    query_sources = rng.integers(0, node_count, 10000, dtype=np.uint32)
+    query_targets = rng.integers(0, node_count, 10000, dtype=np.uint32)
+    start = time.perf_counter()
+    distances = batch.distances(query_sources, query_targets)
+    print(f"10000 queries on {batch.threads} threads: {(time.perf_counter() - start) * 1e3:.1f} ms")
+
+    distances, offsets, nodes = batch.paths(query_sources[:3], query_targets[:3])
+    for i in range(3):
+        print(f"{query_sources[i]} -> {query_targets[i]}: {distances[i]:.1f} via {nodes[offsets[i]:offsets[i + 1]]}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,457 @@
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "batch_query.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+/*
+ * Python bindings of the CSR engines (module shortest_paths).
+ *
+ *     import numpy as np, shortest_paths as sp
+ *     g = sp.Graph(4, np.array([0, 0, 1]), np.array([1, 2, 3]), np.array([5.0, 2.0, 3.0]))
+ *     engine = sp.Engine(g)
+ *     engine.run(0, 3)              # distance, inf if unreachable
+ *     engine.path(3)                # uint32 array of node ids, source first
+ *     engine.distances(0)           # float32 array of every distance from node 0
+ *     batch = sp.BatchEngine(g)
+ *     batch.distances(sources, targets)
+ *
+ * Results are NumPy arrays over memory allocated by C++ and handed to NumPy together with its owner:
+ * nothing is copied at the boundary. Graph arrays (offsets, targets, weights) are read-only views that
+ * keep the graph alive.
+ *
+ * Node ids may come in any integer dtype. They are range-checked in that dtype before being narrowed to
+ * uint32, so a negative id or an int64 id of 2^32 or more raises IndexError rather than wrapping around.
+ *
+ * Threads: every query releases the GIL while it runs. Each Engine and BatchEngine owns a mutex that
+ * guards its scratch state (search arrays, worker engines) for the whole call. The mutex is only taken
+ * once the GIL has been released, and the GIL is never requested while holding it, so the two locks
+ * cannot deadlock. Python threads sharing one engine therefore take turns; threads with an engine each
+ * (all sharing one Graph, which is never written after construction) search in parallel. A BatchEngine
+ * also spreads one call over its own worker threads.
+ *
+ * Unreached nodes read as float("inf") rather than the engines' INFINITY_VALUE.
+ */
+
+namespace py = pybind11;
+
+namespace
+{
+
+using WeightArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using CoordinateArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+constexpr float PYTHON_INFINITY = std::numeric_limits<float>::infinity();
+
+float toPython(float distance) { return distance == INFINITY_VALUE ? PYTHON_INFINITY : distance; }
+
+/**
+ * @brief Hands a C++ vector to NumPy without copying: the array owns the vector through a capsule.
+ */
+template <typename T>
+py::array_t<T> adopt(std::vector<T> &&values, std::vector<py::ssize_t> shape)
+{
+    auto *owner = new std::vector<T>(std::move(values));
+    py::capsule release(owner, [](void *pointer) { delete static_cast<std::vector<T> *>(pointer); });
+    return py::array_t<T>(shape, owner->data(), release);
+}
+
+template <typename T>
+py::array_t<T> adopt(std::vector<T> &&values)
+{
+    py::ssize_t size = static_cast<py::ssize_t>(values.size());
+    return adopt(std::move(values), {size});
+}
+
+/**
+ * @brief Read-only array over memory owned by another Python object (kept alive by the array).
+ */
+template <typename T>
+py::array_t<T> viewOf(const std::vector<T> &values, py::handle owner)
+{
+    py::array_t<T> view({static_cast<py::ssize_t>(values.size())}, values.data(), owner);
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+/**
+ * @brief Checks that a NumPy argument is one-dimensional and returns its length.
+ */
+template <typename Array>
+std::size_t lengthOf(const Array &array, const char *name)
+{
+    if (array.ndim() != 1)
+    {
+        throw std::invalid_argument(std::string(name) + " must be a one-dimensional array");
+    }
+    return static_cast<std::size_t>(array.shape(0));
+}
+
+std::string outOfRange(const char *name, const std::string &node, std::uint32_t nodeCount)
+{
+    return std::string(name) + " holds node " + node + ", the graph has " + std::to_string(nodeCount) + " nodes";
+}
+
+/**
+ * @brief Narrows ids already widened to Wide, refusing any outside [0, nodeCount).
+ */
+template <typename Wide>
+std::vector<std::uint32_t> narrowNodes(const py::array &ids, const char *name, std::uint32_t nodeCount)
+{
+    py::array_t<Wide, py::array::c_style | py::array::forcecast> wide(ids);
+    std::size_t count = lengthOf(wide, name);
+    const Wide *id = wide.data();
+    std::vector<std::uint32_t> nodes(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bool inRange;
+        if constexpr (std::is_signed<Wide>::value)
+        {
+            inRange = id[i] >= 0 && id[i] < static_cast<Wide>(nodeCount);
+        }
+        else
+        {
+            inRange = id[i] < nodeCount;
+        }
+        if (!inRange)
+        {
+            throw std::out_of_range(outOfRange(name, std::to_string(id[i]), nodeCount));
+        }
+        nodes[i] = static_cast<std::uint32_t>(id[i]);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Reads node ids of any integer dtype into uint32, refusing ids outside [0, nodeCount).
+ *
+ * The check runs on the ids widened to (u)int64, before they are narrowed: forcing the argument straight
+ * to uint32 would silently wrap -1 or 2^32 + 5 into a valid-looking id.
+ */
+std::vector<std::uint32_t> readNodes(const py::object &argument, const char *name, std::uint32_t nodeCount)
+{
+    py::array ids = py::array::ensure(argument);
+    if (!ids)
+    {
+        throw py::value_error(std::string(name) + " must be an array of node ids");
+    }
+    char kind = ids.dtype().kind();
+    if (kind == 'u')
+    {
+        return narrowNodes<std::uint64_t>(ids, name, nodeCount);
+    }
+    if (kind != 'i' && ids.size() > 0)
+    {
+        throw py::value_error(std::string(name) + " must hold integer node ids");
+    }
+    return narrowNodes<std::int64_t>(ids, name, nodeCount);
+}
+
+/**
+ * @brief Checks one node id (any Python int) and narrows it.
+ */
+std::uint32_t readNode(std::int64_t node, std::uint32_t nodeCount)
+{
+    if (node < 0 || node >= static_cast<std::int64_t>(nodeCount))
+    {
+        throw std::out_of_range(outOfRange("the query", std::to_string(node), nodeCount));
+    }
+    return static_cast<std::uint32_t>(node);
+}
+
+/**
+ * @brief Builds a graph from parallel edge arrays (and optional n x 2 coordinates).
+ */
+CsrGraph makeGraph(std::uint32_t nodeCount, const py::object &sourcesArgument, const py::object &targetsArgument,
+                   const WeightArray &weights, const py::object &coordinates)
+{
+    std::vector<std::uint32_t> sources = readNodes(sourcesArgument, "sources", nodeCount);
+    std::vector<std::uint32_t> targets = readNodes(targetsArgument, "targets", nodeCount);
+    std::size_t edgeCount = sources.size();
+    if (targets.size() != edgeCount || lengthOf(weights, "weights") != edgeCount)
+    {
+        throw std::invalid_argument("sources, targets and weights must have the same length");
+    }
+    const float *weight = weights.data();
+    for (std::size_t i = 0; i < edgeCount; ++i)
+    {
+        if (!(weight[i] >= 0.0f) || weight[i] == PYTHON_INFINITY)
+        {
+            throw std::invalid_argument("weights must be finite and non-negative");
+        }
+    }
+
+    CsrGraph g;
+    {
+        py::gil_scoped_release release;
+        std::vector<Edge> edges(edgeCount);
+        for (std::size_t i = 0; i < edgeCount; ++i)
+        {
+            edges[i] = {sources[i], targets[i], weight[i]};
+        }
+        g = buildCsrGraph(nodeCount, edges);
+    }
+    if (!coordinates.is_none())
+    {
+        CoordinateArray points = coordinates.cast<CoordinateArray>();
+        if (points.ndim() != 2 || points.shape(0) != static_cast<py::ssize_t>(nodeCount) || points.shape(1) != 2)
+        {
+            throw std::invalid_argument("coordinates must have shape (node_count, 2)");
+        }
+        g.coordinates.resize(nodeCount);
+        for (std::uint32_t node = 0; node < nodeCount; ++node)
+        {
+            g.coordinates[node] = {points.data()[2 * node], points.data()[2 * node + 1]};
+        }
+    }
+    return g;
+}
+
+/**
+ * @brief Reads (sources, targets) arrays as queries, checking lengths and ids.
+ */
+std::vector<Query> makeQueries(const py::object &sourcesArgument, const py::object &targetsArgument,
+                               std::uint32_t nodeCount)
+{
+    std::vector<std::uint32_t> sources = readNodes(sourcesArgument, "sources", nodeCount);
+    std::vector<std::uint32_t> targets = readNodes(targetsArgument, "targets", nodeCount);
+    if (targets.size() != sources.size())
+    {
+        throw std::invalid_argument("sources and targets must have the same length");
+    }
+    std::vector<Query> queries(sources.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        queries[i] = {sources[i], targets[i]};
+    }
+    return queries;
+}
+
+/**
+ * @brief Single-query engine with the mutex that serializes its calls.
+ */
+struct PythonEngine
+{
+    explicit PythonEngine(CsrView g) : nodeCount(g.nodeCount), engine(g) {}
+
+    const std::uint32_t nodeCount; ///< Nodes of the graph, for argument checks (read without the mutex).
+    std::mutex mutex;              ///< Held (without the GIL) for the whole of every call.
+    CsrDijkstra<> engine;          ///< Search state of the last run.
+};
+
+/**
+ * @brief Batch engine bound to Python: BatchQueryEngine for point-to-point queries, plus a pool of
+ * distance-only engines for full distance rows (trees()).
+ */
+class PythonBatchEngine
+{
+public:
+    PythonBatchEngine(const CsrGraph &g, unsigned threads) : graph(g.view()), engine(graph, threads), pool(threads)
+    {
+        treeWorkers.resize(pool.threadCount());
+    }
+
+    py::array_t<float> distances(const py::object &sources, const py::object &targets)
+    {
+        std::vector<Query> queries = makeQueries(sources, targets, graph.nodeCount);
+        std::vector<float> result(queries.size());
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(mutex);
+            engine.answerInto(queries, result.data());
+            for (float &distance : result)
+            {
+                distance = toPython(distance);
+            }
+        }
+        return adopt(std::move(result));
+    }
+
+    py::tuple paths(const py::object &sources, const py::object &targets)
+    {
+        std::vector<Query> queries = makeQueries(sources, targets, graph.nodeCount);
+        std::vector<float> distances(queries.size());
+        std::vector<std::uint64_t> offsets(queries.size() + 1, 0);
+        std::vector<std::uint32_t> nodes;
+        {
+            py::gil_scoped_release release;
+            std::vector<QueryResult> results;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                engine.answer(queries, results, true);
+            }
+            for (std::size_t i = 0; i < queries.size(); ++i)
+            {
+                distances[i] = toPython(results[i].distance);
+                offsets[i + 1] = offsets[i] + results[i].path.size();
+            }
+            nodes.reserve(offsets.back());
+            for (const QueryResult &result : results)
+            {
+                nodes.insert(nodes.end(), result.path.begin(), result.path.end());
+            }
+        }
+        return py::make_tuple(adopt(std::move(distances)), adopt(std::move(offsets)), adopt(std::move(nodes)));
+    }
+
+    /**
+     * @brief Full distance rows from several sources, one row per source, computed on the pool's threads.
+     *
+     * Worker engines are created on first use and kept for later calls.
+     */
+    py::array_t<float> trees(const py::object &sourcesArgument)
+    {
+        std::vector<std::uint32_t> sources = readNodes(sourcesArgument, "sources", graph.nodeCount);
+        std::vector<float> rows(sources.size() * graph.nodeCount);
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(mutex);
+            pool.parallelFor(sources.size(), 1,
+                             [&](unsigned worker, std::size_t begin, std::size_t end)
+                             {
+                                 if (!treeWorkers[worker])
+                                 {
+                                     treeWorkers[worker].reset(new DistanceOnlyDijkstra<>(graph));
+                                 }
+                                 DistanceOnlyDijkstra<> &tree = *treeWorkers[worker];
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     tree.run(sources[i]);
+                                     float *row = rows.data() + i * graph.nodeCount;
+                                     for (std::uint32_t node = 0; node < graph.nodeCount; ++node)
+                                     {
+                                         row[node] = toPython(tree.distance(node));
+                                     }
+                                 }
+                             });
+        }
+        return adopt(std::move(rows),
+                     {static_cast<py::ssize_t>(sources.size()), static_cast<py::ssize_t>(graph.nodeCount)});
+    }
+
+    unsigned threads() const { return engine.threadCount(); }
+
+private:
+    CsrView graph;                                                   ///< Graph queried (kept alive by Python).
+    std::mutex mutex;                                                ///< Held (without the GIL) for every call.
+    BatchQueryEngine<> engine;                                       ///< Per-thread point-to-point engines.
+    ThreadPool pool;                                                 ///< Worker threads of trees().
+    std::vector<std::unique_ptr<DistanceOnlyDijkstra<>>> treeWorkers; ///< Per-thread engines of trees().
+};
+
+} // namespace
+
+PYBIND11_MODULE(shortest_paths, m)
+{
+    m.doc() = "Shortest paths on CSR graphs (C++ Dijkstra engines, NumPy in and out).";
+
+    py::class_<CsrGraph>(m, "Graph", "Directed weighted graph in compressed sparse row form.")
+        .def(py::init(&makeGraph), py::arg("node_count"), py::arg("sources"), py::arg("targets"),
+             py::arg("weights"), py::arg("coordinates") = py::none(),
+             "Builds a graph from parallel edge arrays: edge i goes from sources[i] to targets[i] and costs "
+             "weights[i]. coordinates, if given, is a (node_count, 2) array of positions.")
+        .def_property_readonly("node_count", &CsrGraph::nodeCount)
+        .def_property_readonly("edge_count", &CsrGraph::edgeCount)
+        .def_property_readonly(
+            "offsets", [](py::object self) { return viewOf(self.cast<const CsrGraph &>().offsets, self); },
+            "Row offsets (read-only view): the edges of node u are [offsets[u], offsets[u + 1]).")
+        .def_property_readonly(
+            "targets", [](py::object self) { return viewOf(self.cast<const CsrGraph &>().targets, self); },
+            "Head node of every edge, grouped by tail node (read-only view).")
+        .def_property_readonly(
+            "weights", [](py::object self) { return viewOf(self.cast<const CsrGraph &>().weights, self); },
+            "Cost of every edge, parallel to targets (read-only view).");
+
+    py::class_<PythonEngine>(m, "Engine", "Single-query Dijkstra engine; reuses its buffers between runs.")
+        .def(py::init([](const CsrGraph &g) { return std::make_unique<PythonEngine>(g.view()); }),
+             py::arg("graph"), py::keep_alive<1, 2>())
+        .def(
+            "run",
+            [](PythonEngine &state, std::int64_t sourceId, std::int64_t targetId)
+            {
+                std::uint32_t source = readNode(sourceId, state.nodeCount);
+                std::uint32_t target = readNode(targetId, state.nodeCount);
+                py::gil_scoped_release release;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.engine.run(source, target);
+                return toPython(state.engine.distance(target));
+            },
+            py::arg("source"), py::arg("target"),
+            "Shortest distance from source to target (inf if unreachable). Stops once target is settled.")
+        .def(
+            "distance",
+            [](PythonEngine &state, std::int64_t nodeId)
+            {
+                std::uint32_t node = readNode(nodeId, state.nodeCount);
+                py::gil_scoped_release release;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                return toPython(state.engine.distance(node));
+            },
+            py::arg("node"), "Distance of node in the last run (inf if it was not reached).")
+        .def(
+            "path",
+            [](PythonEngine &state, std::int64_t targetId)
+            {
+                std::uint32_t target = readNode(targetId, state.nodeCount);
+                std::vector<std::uint32_t> nodes;
+                {
+                    py::gil_scoped_release release;
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.engine.pathInto(target, nodes);
+                }
+                return adopt(std::move(nodes));
+            },
+            py::arg("target"), "Node ids of the shortest path of the last run to target, source first.")
+        .def(
+            "distances",
+            [](PythonEngine &state, std::int64_t sourceId)
+            {
+                std::uint32_t source = readNode(sourceId, state.nodeCount);
+                std::vector<float> row(state.nodeCount);
+                {
+                    py::gil_scoped_release release;
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.engine.run(source);
+                    for (std::uint32_t node = 0; node < state.nodeCount; ++node)
+                    {
+                        row[node] = toPython(state.engine.distance(node));
+                    }
+                }
+                return adopt(std::move(row));
+            },
+            py::arg("source"), "Distances from source to every node (float32 array, inf if unreachable).")
+        .def_property_readonly(
+            "settled_count",
+            [](PythonEngine &state)
+            {
+                py::gil_scoped_release release;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                return state.engine.settledCount();
+            },
+            "Nodes settled by the last run.");
+
+    py::class_<PythonBatchEngine>(m, "BatchEngine", "Answers arrays of queries on several worker threads.")
+        .def(py::init<const CsrGraph &, unsigned>(), py::arg("graph"), py::arg("threads") = 0,
+             py::keep_alive<1, 2>(), "threads = 0 uses one worker per hardware thread.")
+        .def("distances", &PythonBatchEngine::distances, py::arg("sources"), py::arg("targets"),
+             "Distance of every (sources[i], targets[i]) pair (float32 array).")
+        .def("paths", &PythonBatchEngine::paths, py::arg("sources"), py::arg("targets"),
+             "(distances, offsets, nodes): the path of query i is nodes[offsets[i]:offsets[i + 1]].")
+        .def("trees", &PythonBatchEngine::trees, py::arg("sources"),
+             "Distances from every source to every node, as a (len(sources), node_count) float32 array.")
+        .def_property_readonly("threads", &PythonBatchEngine::threads);
+}
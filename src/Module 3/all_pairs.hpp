@@ -0,0 +1,277 @@
+#ifndef ALL_PAIRS_HPP_
+#define ALL_PAIRS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+
+/**
+ * @brief Tuning knobs for the all-pairs computation.
+ */
+struct AllPairsOptions
+{
+    unsigned threads = 0;  ///< Worker threads (0 = one per hardware thread).
+    bool allowSimd = true; ///< false forces the scalar kernel (results are the same either way).
+};
+
+/**
+ * @brief Complete V x V distance table with the predecessor matrix to rebuild any path.
+ *
+ * Computed by a cache-tiled Floyd-Warshall. The matrix is cut into TILE x TILE tiles and, for every
+ * diagonal tile k in turn:
+ *  1. the diagonal tile (k, k) runs plain Floyd-Warshall on itself;
+ *  2. the tiles of row k and column k are updated through it, in parallel;
+ *  3. every other tile (i, j) takes min(d(i, j), d(i, k) + d(k, j)) from tiles (i, k) and (k, j), in parallel.
+ * Each update works on three tiles that stay in cache, instead of streaming the whole matrix V times.
+ *
+ * The min-plus kernel runs 8 columns per AVX2 instruction when the CPU has it and falls back to scalar
+ * code otherwise; both do the same comparisons in the same order, so the tables are identical.
+ *
+ * Cost is O(V^3) time and 8 * V^2 bytes, meant for dense graphs of a few thousand nodes. Distances are
+ * sums in Floyd-Warshall order, so with non-integer weights they can differ from Dijkstra in the last bit.
+ */
+class AllPairsMatrix
+{
+public:
+    static constexpr std::uint32_t TILE = 64; ///< Tile side, a multiple of the 8-float vector width.
+
+    /**
+     * @brief Computes all shortest distances of g (weights must be non-negative).
+     */
+    static AllPairsMatrix compute(CsrView g, const AllPairsOptions &options = AllPairsOptions())
+    {
+        AllPairsMatrix matrix;
+        matrix.initialize(g);
+        // The kernel has no 512-bit version: AVX-512 machines run the AVX2 one.
+        matrix.simd = options.allowSimd ? std::min(detectSimdLevel(), SimdLevel::Avx2) : SimdLevel::Scalar;
+        matrix.solve(options.threads);
+        return matrix;
+    }
+
+    std::uint32_t nodeCount() const { return nodes; }
+
+    /**
+     * @brief Shortest distance from -> to, or INFINITY_VALUE if to cannot be reached.
+     */
+    float distance(std::uint32_t from, std::uint32_t to) const { return distances[index(from, to)]; }
+
+    /**
+     * @brief Node before to on the shortest path from -> to, or NO_NODE (unreachable, or from == to).
+     */
+    std::uint32_t predecessor(std::uint32_t from, std::uint32_t to) const { return predecessors[index(from, to)]; }
+
+    /**
+     * @brief Distances from one node to every node (nodeCount() values, then padding).
+     */
+    const float *row(std::uint32_t from) const { return distances.data() + index(from, 0); }
+
+    /**
+     * @brief Shortest path from -> to, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t from, std::uint32_t to) const
+    {
+        std::vector<std::uint32_t> result;
+        if (distance(from, to) == INFINITY_VALUE)
+        {
+            return result;
+        }
+        for (std::uint32_t node = to; node != from; node = predecessor(from, node))
+        {
+            result.push_back(node);
+        }
+        result.push_back(from);
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Instruction set the kernel ran with.
+     */
+    SimdLevel simdLevel() const { return simd; }
+
+private:
+    std::uint32_t nodes = 0;                 ///< Number of real nodes.
+    std::uint32_t stride = 0;                ///< Row length, nodes rounded up to whole tiles.
+    std::vector<float> distances;            ///< stride x stride distances, row-major.
+    std::vector<std::uint32_t> predecessors; ///< stride x stride predecessors, row-major.
+    SimdLevel simd = SimdLevel::Scalar;      ///< Kernel used by solve().
+
+    std::size_t index(std::uint32_t from, std::uint32_t to) const { return std::size_t(from) * stride + to; }
+
+    /**
+     * @brief Fills the matrix with 0 on the diagonal, the shortest direct edges, and infinity elsewhere.
+     *
+     * Padding rows and columns stay infinite, so they never offer a shorter path.
+     */
+    void initialize(CsrView g)
+    {
+        nodes = g.nodeCount;
+        stride = (nodes + TILE - 1) / TILE * TILE;
+        distances.assign(std::size_t(stride) * stride, INFINITY_VALUE);
+        predecessors.assign(std::size_t(stride) * stride, NO_NODE);
+        for (std::uint32_t node = 0; node < stride; ++node)
+        {
+            distances[index(node, node)] = 0.0f;
+        }
+        for (std::uint32_t node = 0; node < nodes; ++node)
+        {
+            for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+            {
+                std::size_t slot = index(node, g.targets[edge]);
+                if (g.weights[edge] < distances[slot])
+                {
+                    distances[slot] = g.weights[edge];
+                    predecessors[slot] = node;
+                }
+            }
+        }
+    }
+
+    void solve(unsigned threads)
+    {
+        const std::uint32_t tiles = stride / TILE;
+        for (std::uint32_t k = 0; k < tiles; ++k)
+        {
+            // 1. Diagonal tile.
+            update(k, k, k);
+
+            // 2. Row k and column k: tile t < tiles is (k, t), tile tiles + t is (t, k).
+            parallelFor(2 * std::size_t(tiles), threads, 1,
+                        [&](unsigned, std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t t = begin; t < end; ++t)
+                            {
+                                std::uint32_t other = static_cast<std::uint32_t>(t % tiles);
+                                if (other == k)
+                                {
+                                    continue;
+                                }
+                                if (t < tiles)
+                                {
+                                    update(k, other, k);
+                                }
+                                else
+                                {
+                                    update(other, k, k);
+                                }
+                            }
+                        });
+
+            // 3. Every remaining tile, through row k and column k.
+            parallelFor(std::size_t(tiles) * tiles, threads, 1,
+                        [&](unsigned, std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t t = begin; t < end; ++t)
+                            {
+                                std::uint32_t i = static_cast<std::uint32_t>(t / tiles);
+                                std::uint32_t j = static_cast<std::uint32_t>(t % tiles);
+                                if (i != k && j != k)
+                                {
+                                    update(i, j, k);
+                                }
+                            }
+                        });
+        }
+    }
+
+    /**
+     * @brief Relaxes tile (i, j) through the nodes of tile k: d(a, b) = min(d(a, b), d(a, c) + d(c, b)).
+     *
+     * Loops run c, then a, then b, as in plain Floyd-Warshall, so the call is also right when the tiles
+     * overlap (phases 1 and 2). On improvement the predecessor of b comes from the (c, b) entry.
+     */
+    void update(std::uint32_t i, std::uint32_t j, std::uint32_t k)
+    {
+        float *target = distances.data() + index(i * TILE, j * TILE);
+        std::uint32_t *targetPredecessors = predecessors.data() + index(i * TILE, j * TILE);
+        const float *left = distances.data() + index(i * TILE, k * TILE);
+        const float *right = distances.data() + index(k * TILE, j * TILE);
+        const std::uint32_t *rightPredecessors = predecessors.data() + index(k * TILE, j * TILE);
+#if SIMD_X86
+        if (simd == SimdLevel::Avx2)
+        {
+            updateAvx2(target, targetPredecessors, left, right, rightPredecessors, stride);
+            return;
+        }
+#endif
+        updateScalar(target, targetPredecessors, left, right, rightPredecessors, stride);
+    }
+
+    static void updateScalar(float *target, std::uint32_t *targetPredecessors, const float *left, const float *right,
+                             const std::uint32_t *rightPredecessors, std::size_t stride)
+    {
+        for (std::uint32_t c = 0; c < TILE; ++c)
+        {
+            const float *rightRow = right + c * stride;
+            const std::uint32_t *rightPredecessorRow = rightPredecessors + c * stride;
+            for (std::uint32_t a = 0; a < TILE; ++a)
+            {
+                const float through = left[a * stride + c];
+                if (through == INFINITY_VALUE)
+                {
+                    continue; // Nothing can be reached through c.
+                }
+                float *row = target + a * stride;
+                std::uint32_t *predecessorRow = targetPredecessors + a * stride;
+                for (std::uint32_t b = 0; b < TILE; ++b)
+                {
+                    float candidate = through + rightRow[b];
+                    if (candidate < row[b])
+                    {
+                        row[b] = candidate;
+                        predecessorRow[b] = rightPredecessorRow[b];
+                    }
+                }
+            }
+        }
+    }
+
+#if SIMD_X86
+    SIMD_TARGET_AVX2 static void updateAvx2(float *target, std::uint32_t *targetPredecessors, const float *left,
+                                            const float *right, const std::uint32_t *rightPredecessors,
+                                            std::size_t stride)
+    {
+        for (std::uint32_t c = 0; c < TILE; ++c)
+        {
+            const float *rightRow = right + c * stride;
+            const std::uint32_t *rightPredecessorRow = rightPredecessors + c * stride;
+            for (std::uint32_t a = 0; a < TILE; ++a)
+            {
+                const float through = left[a * stride + c];
+                if (through == INFINITY_VALUE)
+                {
+                    continue;
+                }
+                const __m256 broadcast = _mm256_set1_ps(through);
+                float *row = target + a * stride;
+                std::uint32_t *predecessorRow = targetPredecessors + a * stride;
+                for (std::uint32_t b = 0; b < TILE; b += 8)
+                {
+                    __m256 candidate = _mm256_add_ps(broadcast, _mm256_loadu_ps(rightRow + b));
+                    __m256 current = _mm256_loadu_ps(row + b);
+                    __m256 better = _mm256_cmp_ps(candidate, current, _CMP_LT_OQ);
+                    if (_mm256_testz_ps(better, better))
+                    {
+                        continue;
+                    }
+                    _mm256_storeu_ps(row + b, _mm256_blendv_ps(current, candidate, better));
+                    // Predecessors go through the same float blend: it only moves bits.
+                    __m256i *predecessorSlot = reinterpret_cast<__m256i *>(predecessorRow + b);
+                    __m256 oldPredecessor = _mm256_castsi256_ps(_mm256_loadu_si256(predecessorSlot));
+                    __m256 newPredecessor = _mm256_castsi256_ps(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rightPredecessorRow + b)));
+                    _mm256_storeu_si256(predecessorSlot,
+                                        _mm256_castps_si256(_mm256_blendv_ps(oldPredecessor, newPredecessor, better)));
+                }
+            }
+        }
+    }
+#endif
+};
+
+#endif // ALL_PAIRS_HPP_
@@ -0,0 +1,157 @@
+#ifndef ASTAR_HPP_
+#define ASTAR_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+#include "query_context.hpp"
+
+/**
+ * @brief Heuristic that knows nothing: A* with it is plain Dijkstra.
+ */
+struct ZeroHeuristic
+{
+    float operator()(std::uint32_t, std::uint32_t) const { return 0.0f; }
+};
+
+/**
+ * @brief Straight-line (Euclidean) distance between node positions, times a scale factor.
+ *
+ * Admissible when no edge is cheaper than scale times the straight-line distance between its ends,
+ * e.g. weights in kilometres with scale = 1, or travel times with scale = 1 / maximum speed.
+ */
+struct EuclideanHeuristic
+{
+    const Coordinate *coordinates; ///< Node positions (CsrView::coordinates).
+    double scale;                  ///< Cost per unit of length.
+
+    explicit EuclideanHeuristic(const Coordinate *coords, double costPerUnit = 1.0)
+        : coordinates(coords), scale(costPerUnit) {}
+
+    float operator()(std::uint32_t node, std::uint32_t target) const
+    {
+        double dx = coordinates[node].x - coordinates[target].x;
+        double dy = coordinates[node].y - coordinates[target].y;
+        return static_cast<float>(scale * std::sqrt(dx * dx + dy * dy));
+    }
+};
+
+/**
+ * @brief Manhattan (|dx| + |dy|) distance between node positions, times a scale factor.
+ *
+ * Tighter than Euclidean on grid-like graphs where moves are axis-aligned, but only admissible when
+ * edges follow the axes.
+ */
+struct ManhattanHeuristic
+{
+    const Coordinate *coordinates; ///< Node positions (CsrView::coordinates).
+    double scale;                  ///< Cost per unit of length.
+
+    explicit ManhattanHeuristic(const Coordinate *coords, double costPerUnit = 1.0)
+        : coordinates(coords), scale(costPerUnit) {}
+
+    float operator()(std::uint32_t node, std::uint32_t target) const
+    {
+        double dx = std::fabs(coordinates[node].x - coordinates[target].x);
+        double dy = std::fabs(coordinates[node].y - coordinates[target].y);
+        return static_cast<float>(scale * (dx + dy));
+    }
+};
+
+/**
+ * @brief Goal-directed shortest-path search (A*) on a CSR graph.
+ *
+ * Nodes are popped by f = g + h, where g is the distance found so far and h a lower bound of the
+ * remaining distance to the target given by the heuristic. Nodes that point away from the target get a
+ * large h and are popped late or never, so far fewer nodes are settled than with the blind search.
+ *
+ * The heuristic is any callable h(node, target) -> float, fixed at compile time so the call inlines.
+ * It must be admissible (never overestimate); nodes are reopened when a shorter path to them shows
+ * up, so it does not need to be consistent. With a consistent heuristic no node is reopened.
+ *
+ * @tparam Heuristic Callable as float(std::uint32_t node, std::uint32_t target).
+ * @tparam Frontier Heap keyed by f.
+ */
+template <typename Heuristic, typename Frontier = BinaryHeap>
+class AStar
+{
+public:
+    /**
+     * @brief Creates the engine. The graph (and whatever the heuristic points to) must outlive it.
+     */
+    AStar(CsrView g, Heuristic h) : graph(g), heuristic(h), frontier(g.nodeCount), state(g.nodeCount) {}
+
+    /**
+     * @brief Computes the shortest distance from source to target.
+     *
+     * @return The distance, or INFINITY_VALUE if target cannot be reached.
+     */
+    float run(std::uint32_t source, std::uint32_t target)
+    {
+        state.reset();
+        frontier.clear();
+        settledNodes = 0;
+
+        state.reach(source, 0.0f, NO_NODE);
+        frontier.push(source, heuristic(source, target));
+
+        std::uint32_t current;
+        float key;
+        while (frontier.pop(current, key))
+        {
+            const float base = state.distance(current);
+            if (key > base + heuristic(current, target))
+            {
+                continue; // Outdated copy left behind by a lazy heap.
+            }
+            settledNodes++;
+            if (current == target)
+            {
+                break;
+            }
+            for (std::uint32_t edge = graph.firstEdge(current); edge < graph.lastEdge(current); ++edge)
+            {
+                std::uint32_t next = graph.targets[edge];
+                float newDistance = base + graph.weights[edge];
+                if (newDistance < state.distance(next))
+                {
+                    state.reach(next, newDistance, current);
+                    frontier.push(next, newDistance + heuristic(next, target));
+                }
+            }
+        }
+        return state.distance(target);
+    }
+
+    /**
+     * @brief Distance from the last source, or INFINITY_VALUE if the node was not reached.
+     */
+    float distance(std::uint32_t node) const { return state.distance(node); }
+
+    /**
+     * @brief Nodes popped (expanded) by the last run.
+     */
+    std::uint32_t settledCount() const { return settledNodes; }
+
+    /**
+     * @brief Shortest path from the last source to target, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t target) const
+    {
+        std::vector<std::uint32_t> result;
+        state.writePath(target, result);
+        return result;
+    }
+
+private:
+    CsrView graph;                  ///< Graph being searched.
+    Heuristic heuristic;            ///< Lower bound of the remaining distance.
+    Frontier frontier;              ///< Queue of open nodes keyed by g + h.
+    QueryContext state;             ///< Reusable per-node distances and predecessors.
+    std::uint32_t settledNodes = 0; ///< Nodes expanded by the last run.
+};
+
+#endif // ASTAR_HPP_
@@ -0,0 +1,163 @@
+#ifndef BATCH_QUERY_HPP_
+#define BATCH_QUERY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief One point-to-point route request.
+ */
+struct Query
+{
+    std::uint32_t source; ///< Starting node.
+    std::uint32_t target; ///< Destination node.
+};
+
+/**
+ * @brief Answer to one Query.
+ */
+struct QueryResult
+{
+    float distance = INFINITY_VALUE;  ///< Shortest distance, or INFINITY_VALUE if unreachable.
+    std::uint32_t settled = 0;        ///< Nodes settled to answer the query.
+    std::vector<std::uint32_t> path;  ///< Nodes from source to target (empty if unreachable or not requested).
+};
+
+/**
+ * @brief Answers many (source, target) queries in parallel over one shared, immutable graph.
+ *
+ * The engine keeps one CsrDijkstra per worker thread. Each worker owns its scratch arrays (distances,
+ * predecessors, heap) and reads the graph through a shared view, so nothing is copied or locked while
+ * a batch runs. Queries are handed out in small chunks so long and short queries balance across cores.
+ * The worker threads are started by the constructor and stay parked between batches (see ThreadPool), so
+ * a batch costs no thread creation. One engine answers one batch at a time.
+ *
+ * Every query runs exactly the same relaxation sequence as a single-threaded CsrDijkstra, so results
+ * do not depend on the thread count.
+ *
+ * answer() fills QueryResult objects (one path vector per query); answerInto() writes into flat arrays
+ * owned by the caller. Since the threads are already running and every worker's scratch arrays were sized
+ * by the constructor, an answerInto() batch allocates nothing on any thread. With TrackPaths = false the
+ * workers are distance-only engines that never record predecessors, and no paths are produced.
+ *
+ * @tparam Frontier Heap used by every worker.
+ * @tparam TrackPaths Whether the workers record predecessors (needed for paths).
+ */
+template <typename Frontier = BinaryHeap, bool TrackPaths = true>
+class BatchQueryEngine
+{
+public:
+    /**
+     * @brief Starts the worker threads and creates their engines. The graph must outlive the engine.
+     *
+     * @param g Graph to query.
+     * @param threads Number of worker threads (0 = one per hardware thread).
+     */
+    explicit BatchQueryEngine(CsrView g, unsigned threads = 0) : graph(g), pool(threads)
+    {
+        workers.reserve(pool.threadCount());
+        for (unsigned i = 0; i < pool.threadCount(); ++i)
+        {
+            workers.emplace_back(graph);
+        }
+    }
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * @brief Answers a batch of queries into results (resized to queries.size()).
+     *
+     * @param queries Route requests.
+     * @param results Receives one answer per query, in the same order.
+     * @param withPaths Set to false to only compute distances (always the case without TrackPaths).
+     */
+    void answer(const std::vector<Query> &queries, std::vector<QueryResult> &results, bool withPaths = true)
+    {
+        results.resize(queries.size());
+        pool.parallelFor(queries.size(), GRAIN,
+                         [&](unsigned worker, std::size_t begin, std::size_t end)
+                         {
+                             Worker &engine = workers[worker];
+                             for (std::size_t i = begin; i < end; ++i)
+                             {
+                                 const Query &query = queries[i];
+                                 QueryResult &result = results[i];
+                                 engine.run(query.source, query.target);
+                                 result.distance = engine.distance(query.target);
+                                 result.settled = engine.settledCount();
+                                 result.path.clear();
+                                 if constexpr (TrackPaths)
+                                 {
+                                     if (withPaths)
+                                     {
+                                         engine.pathInto(query.target, result.path);
+                                     }
+                                 }
+                             }
+                         });
+    }
+
+    /**
+     * @brief Answers a batch of queries into caller-owned flat arrays, without any allocation.
+     *
+     * Query i writes distances[i] and, when both paths and pathLengths are given, its path to
+     * paths + i * pathStride (source first) with its length in pathLengths[i]. A path longer than pathStride
+     * is not written; its length is still reported so the caller can retry that query with a larger stride.
+     *
+     * @param queries Route requests.
+     * @param distances queries.size() slots for the distances.
+     * @param pathLengths queries.size() slots for the path lengths, or nullptr for distances only.
+     * @param paths queries.size() * pathStride slots for the paths, or nullptr for distances only.
+     *              Paths are only written when both pointers are given.
+     * @param pathStride Slots reserved per query in paths.
+     */
+    void answerInto(const std::vector<Query> &queries, float *distances, std::uint32_t *pathLengths = nullptr,
+                    std::uint32_t *paths = nullptr, std::size_t pathStride = 0)
+    {
+        pool.parallelFor(queries.size(), GRAIN,
+                         [&](unsigned worker, std::size_t begin, std::size_t end)
+                         {
+                             Worker &engine = workers[worker];
+                             for (std::size_t i = begin; i < end; ++i)
+                             {
+                                 const Query &query = queries[i];
+                                 engine.run(query.source, query.target);
+                                 distances[i] = engine.distance(query.target);
+                                 if constexpr (TrackPaths)
+                                 {
+                                     if (paths != nullptr && pathLengths != nullptr)
+                                     {
+                                         pathLengths[i] = static_cast<std::uint32_t>(
+                                             engine.pathInto(query.target, paths + i * pathStride, pathStride));
+                                     }
+                                 }
+                             }
+                         });
+    }
+
+    /**
+     * @brief Convenience overload returning a fresh result vector.
+     */
+    std::vector<QueryResult> answer(const std::vector<Query> &queries, bool withPaths = true)
+    {
+        std::vector<QueryResult> results;
+        answer(queries, results, withPaths);
+        return results;
+    }
+
+private:
+    using Worker = CsrDijkstra<Frontier, NoTrace, TrackPaths>;
+
+    static constexpr std::size_t GRAIN = 16; ///< Queries handed to a worker at a time.
+
+    CsrView graph;               ///< Shared graph.
+    ThreadPool pool;             ///< Worker threads, parked between batches.
+    std::vector<Worker> workers; ///< One engine (scratch state) per thread.
+};
+
+#endif // BATCH_QUERY_HPP_
@@ -0,0 +1,196 @@
+#ifndef BIDIRECTIONAL_DIJKSTRA_HPP_
+#define BIDIRECTIONAL_DIJKSTRA_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+#include "query_context.hpp"
+
+/**
+ * @brief Point-to-point Dijkstra that searches from both ends at once.
+ *
+ * A forward search grows from the source over the graph and a backward search grows from the target
+ * over the reverse graph. Each step advances the side whose next node is closer, so both balls grow
+ * at the same pace and meet in the middle: on road-like graphs two balls of radius d/2 hold about half
+ * the nodes of one ball of radius d.
+ *
+ * Whenever an edge (u, v) is relaxed and its far end already has a distance from the other side, the
+ * path source -> u -> v -> target is a candidate and the best one is kept (best). The search stops as
+ * soon as minForward + minBackward >= best: any path not seen yet would have to be longer.
+ *
+ * @tparam Frontier Heap used by both sides.
+ */
+template <typename Frontier = BinaryHeap>
+class BidirectionalDijkstra
+{
+public:
+    /**
+     * @brief Creates the engine. Both graphs must outlive it.
+     *
+     * @param forward Graph to search.
+     * @param backward Its reverse graph (see reverseGraph()).
+     */
+    BidirectionalDijkstra(CsrView forward, CsrView backward)
+        : sides{Side(forward), Side(backward)}
+    {
+    }
+
+    /**
+     * @brief Computes the shortest distance from source to target.
+     *
+     * @return The distance, or INFINITY_VALUE if target cannot be reached.
+     */
+    float run(std::uint32_t source, std::uint32_t target)
+    {
+        startNode = source;
+        endNode = target;
+        best = INFINITY_VALUE;
+        meetFrom = NO_NODE;
+        meetTo = NO_NODE;
+        settledNodes = 0;
+        for (Side &side : sides)
+        {
+            side.state.reset();
+            side.frontier.clear();
+        }
+
+        sides[FORWARD].state.reach(source, 0.0f, NO_NODE);
+        sides[FORWARD].frontier.push(source, 0.0f);
+        sides[BACKWARD].state.reach(target, 0.0f, NO_NODE);
+        sides[BACKWARD].frontier.push(target, 0.0f);
+        if (source == target)
+        {
+            best = 0.0f;
+            return best;
+        }
+
+        while (!sides[FORWARD].frontier.empty() && !sides[BACKWARD].frontier.empty())
+        {
+            float forwardMin = sides[FORWARD].frontier.top().key;
+            float backwardMin = sides[BACKWARD].frontier.top().key;
+            if (forwardMin + backwardMin >= best)
+            {
+                break; // No unseen path can beat the best meeting found so far.
+            }
+            if (forwardMin <= backwardMin)
+            {
+                step(FORWARD);
+            }
+            else
+            {
+                step(BACKWARD);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Distance found by the last run, or INFINITY_VALUE.
+     */
+    float distance() const { return best; }
+
+    /**
+     * @brief Nodes settled by both sides during the last run.
+     */
+    std::uint32_t settledCount() const { return settledNodes; }
+
+    /**
+     * @brief Shortest path of the last run, stitched from both searches; empty if there is none.
+     *
+     * The forward half is read from the forward predecessors (source -> meetFrom), the backward half from
+     * the backward predecessors, which point towards the target (meetTo -> target).
+     */
+    std::vector<std::uint32_t> path() const
+    {
+        std::vector<std::uint32_t> result;
+        if (startNode == endNode)
+        {
+            result.push_back(startNode);
+            return result;
+        }
+        if (meetFrom == NO_NODE)
+        {
+            return result;
+        }
+        for (std::uint32_t node = meetFrom; node != NO_NODE; node = sides[FORWARD].state.predecessor(node))
+        {
+            result.push_back(node);
+        }
+        std::reverse(result.begin(), result.end());
+        for (std::uint32_t node = meetTo; node != NO_NODE; node = sides[BACKWARD].state.predecessor(node))
+        {
+            result.push_back(node);
+        }
+        return result;
+    }
+
+private:
+    static constexpr int FORWARD = 0;
+    static constexpr int BACKWARD = 1;
+
+    /**
+     * @brief Graph, heap and search state of one direction.
+     */
+    struct Side
+    {
+        CsrView graph;
+        Frontier frontier;
+        QueryContext state;
+
+        explicit Side(CsrView g) : graph(g), frontier(g.nodeCount), state(g.nodeCount) {}
+    };
+
+    Side sides[2];                     ///< Forward and backward searches.
+    std::uint32_t startNode = NO_NODE; ///< Source of the last run.
+    std::uint32_t endNode = NO_NODE;   ///< Target of the last run.
+    float best = INFINITY_VALUE;       ///< Length of the best source-target path seen.
+    std::uint32_t meetFrom = NO_NODE;  ///< Forward end of the edge closing the best path.
+    std::uint32_t meetTo = NO_NODE;    ///< Backward end of the edge closing the best path.
+    std::uint32_t settledNodes = 0;    ///< Nodes settled by both sides.
+
+    /**
+     * @brief Settles the next node of one side and relaxes its edges.
+     */
+    void step(int direction)
+    {
+        Side &side = sides[direction];
+        const QueryContext &other = sides[1 - direction].state;
+        std::uint32_t current = NO_NODE;
+        float key = 0.0f;
+        side.frontier.pop(current, key);
+        if (side.state.isSettled(current))
+        {
+            return; // Outdated copy left behind by a lazy heap.
+        }
+        side.state.settle(current);
+        settledNodes++;
+
+        const float base = side.state.distance(current);
+        for (std::uint32_t edge = side.graph.firstEdge(current); edge < side.graph.lastEdge(current); ++edge)
+        {
+            std::uint32_t next = side.graph.targets[edge];
+            float newDistance = base + side.graph.weights[edge];
+            if (!side.state.isSettled(next) && newDistance < side.state.distance(next))
+            {
+                side.state.reach(next, newDistance, current);
+                side.frontier.push(next, newDistance);
+            }
+            if (other.reached(next))
+            {
+                float candidate = newDistance + other.distance(next);
+                if (candidate < best)
+                {
+                    best = candidate;
+                    // Store the meeting edge in forward orientation (tail reached from the source).
+                    meetFrom = direction == FORWARD ? current : next;
+                    meetTo = direction == FORWARD ? next : current;
+                }
+            }
+        }
+    }
+};
+
+#endif // BIDIRECTIONAL_DIJKSTRA_HPP_
@@ -0,0 +1,716 @@
+#ifndef CONTRACTION_HIERARCHY_HPP_
+#define CONTRACTION_HIERARCHY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+#include "parallel.hpp"
+#include "query_context.hpp"
+
+/**
+ * @brief Edge of a contraction hierarchy: an original edge or a shortcut standing for two edges.
+ */
+struct HierarchyArc
+{
+    std::uint32_t target; ///< Other end of the arc.
+    float weight;         ///< Length of the arc.
+    std::uint32_t middle; ///< Contracted node the shortcut bypasses, or NO_NODE for an original edge.
+};
+
+/**
+ * @brief Tuning knobs for the contraction (preprocessing) step.
+ */
+struct ContractionOptions
+{
+    unsigned threads = 0;                   ///< Worker threads (0 = one per hardware thread).
+    std::uint32_t witnessSettleLimit = 500; ///< Nodes a witness search may settle before giving up.
+    std::uint32_t prioritySettleLimit = 50; ///< Same limit while only estimating priorities.
+};
+
+/**
+ * @brief Contraction hierarchy: a graph preprocessed for very fast point-to-point queries.
+ *
+ * Nodes are removed ("contracted") one by one, least important first. When node v is removed, every
+ * pair of neighbors u -> v -> w whose shortest connection goes through v gets a shortcut u -> w of the
+ * same length, so distances among the remaining nodes never change. The result is the original graph
+ * plus shortcuts, with every node ranked by contraction order. A query then only has to walk upwards in
+ * rank from both ends (see HierarchyQuery), which on road graphs touches a few hundred nodes.
+ *
+ * For each node, up lists the arcs leaving it towards higher ranks and down lists the arcs entering it
+ * from higher ranks (stored with the higher-ranked tail as target). Both are packed like a CSR graph.
+ *
+ * Preprocessing contracts independent node sets in rounds: a node is picked when its priority beats
+ * all of its remaining neighbors, and the nodes picked in one round are simulated in parallel.
+ */
+class ContractionHierarchy
+{
+public:
+    std::vector<std::uint32_t> rank;         ///< Contraction order of every node (0 = contracted first).
+    std::vector<std::uint32_t> upOffsets;    ///< nodeCount + 1 offsets into upArcs.
+    std::vector<HierarchyArc> upArcs;        ///< Arcs v -> target with rank[target] > rank[v].
+    std::vector<std::uint32_t> downOffsets;  ///< nodeCount + 1 offsets into downArcs.
+    std::vector<HierarchyArc> downArcs;      ///< Arcs target -> v with rank[target] > rank[v].
+    std::uint32_t shortcutCount = 0;         ///< Number of shortcut arcs added.
+
+    std::uint32_t nodeCount() const { return static_cast<std::uint32_t>(rank.size()); }
+
+    /**
+     * @brief Contracts every node of g and returns the hierarchy.
+     *
+     * @param g Graph to preprocess (weights must be non-negative).
+     * @param options Thread count and witness search limits.
+     */
+    static ContractionHierarchy build(CsrView g, const ContractionOptions &options = ContractionOptions())
+    {
+        Builder builder(g, options);
+        return builder.run();
+    }
+
+    /**
+     * @brief Arc from -> to stored in the up list of from, or nullptr.
+     */
+    const HierarchyArc *findUp(std::uint32_t from, std::uint32_t to) const
+    {
+        return find(upArcs, upOffsets, from, to);
+    }
+
+    /**
+     * @brief Arc from -> to stored in the down list of to, or nullptr.
+     */
+    const HierarchyArc *findDown(std::uint32_t from, std::uint32_t to) const
+    {
+        return find(downArcs, downOffsets, to, from);
+    }
+
+    /**
+     * @brief Appends the original nodes of arc from -> to (excluding from, including to) to path.
+     *
+     * Shortcuts are expanded with an explicit stack: from -> middle is looked up in the down list of
+     * middle and middle -> to in its up list, since middle was contracted before both ends.
+     */
+    void unpack(std::uint32_t from, std::uint32_t to, std::uint32_t middle, std::vector<std::uint32_t> &path) const
+    {
+        std::vector<HierarchyArc> stack; // target is the arc head, weight is unused, middle as in HierarchyArc.
+        std::vector<std::uint32_t> tails;
+        stack.push_back({to, 0.0f, middle});
+        tails.push_back(from);
+        while (!stack.empty())
+        {
+            HierarchyArc arc = stack.back();
+            std::uint32_t tail = tails.back();
+            stack.pop_back();
+            tails.pop_back();
+            if (arc.middle == NO_NODE)
+            {
+                path.push_back(arc.target);
+                continue;
+            }
+            const HierarchyArc *second = findUp(arc.middle, arc.target);
+            const HierarchyArc *first = findDown(tail, arc.middle);
+            // Second half goes first on the stack so the first half is expanded first.
+            stack.push_back({arc.target, 0.0f, second->middle});
+            tails.push_back(arc.middle);
+            stack.push_back({arc.middle, 0.0f, first->middle});
+            tails.push_back(tail);
+        }
+    }
+
+private:
+    static const HierarchyArc *find(const std::vector<HierarchyArc> &arcs, const std::vector<std::uint32_t> &offsets,
+                                     std::uint32_t owner, std::uint32_t target)
+    {
+        for (std::uint32_t i = offsets[owner]; i < offsets[owner + 1]; ++i)
+        {
+            if (arcs[i].target == target)
+            {
+                return &arcs[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Shortcut found while simulating the contraction of a node.
+     */
+    struct Shortcut
+    {
+        std::uint32_t from;
+        std::uint32_t to;
+        float weight;
+        std::uint32_t middle;
+    };
+
+    /**
+     * @brief Scratch state of one witness-search thread.
+     */
+    struct WitnessSearch
+    {
+        QueryContext state;
+        BinaryHeap heap;
+        std::vector<std::uint32_t> targetMark; ///< Equal to mark for the targets of the current search.
+        std::uint32_t mark = 0;
+
+        explicit WitnessSearch(std::uint32_t nodeCount) : state(nodeCount), heap(nodeCount), targetMark(nodeCount, 0) {}
+    };
+
+    /**
+     * @brief Contraction state: the shrinking graph with its shortcuts, priorities and the output arcs.
+     */
+    class Builder
+    {
+    public:
+        Builder(CsrView g, const ContractionOptions &opts)
+            : nodeCount(g.nodeCount), options(opts), outArcs(g.nodeCount), inArcs(g.nodeCount),
+              contracted(g.nodeCount, 0), deletedNeighbors(g.nodeCount, 0), level(g.nodeCount, 0),
+              priority(g.nodeCount, 0), up(g.nodeCount), down(g.nodeCount)
+        {
+            for (std::uint32_t node = 0; node < nodeCount; ++node)
+            {
+                for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+                {
+                    if (g.targets[edge] != node)
+                    {
+                        addArc(node, g.targets[edge], g.weights[edge], NO_NODE, false);
+                    }
+                }
+            }
+            unsigned threads = resolveThreadCount(options.threads);
+            searches.reserve(threads);
+            for (unsigned i = 0; i < threads; ++i)
+            {
+                searches.emplace_back(nodeCount);
+            }
+        }
+
+        ContractionHierarchy run()
+        {
+            ContractionHierarchy ch;
+            ch.rank.assign(nodeCount, NO_NODE);
+
+            std::vector<std::uint32_t> remaining(nodeCount);
+            for (std::uint32_t node = 0; node < nodeCount; ++node)
+            {
+                remaining[node] = node;
+            }
+            updatePriorities(remaining);
+
+            std::uint32_t nextRank = 0;
+            std::vector<std::uint8_t> picked(nodeCount, 0);
+            std::vector<std::uint32_t> independent;
+            std::vector<std::vector<Shortcut>> shortcuts;
+            std::vector<std::uint32_t> touched;
+            std::vector<std::uint8_t> isTouched(nodeCount, 0);
+            while (!remaining.empty())
+            {
+                // 1. Pick every node whose priority beats all of its remaining neighbors.
+                parallelFor(remaining.size(), options.threads, 1024,
+                            [&](unsigned, std::size_t begin, std::size_t end)
+                            {
+                                for (std::size_t i = begin; i < end; ++i)
+                                {
+                                    picked[remaining[i]] = isLocalMinimum(remaining[i]) ? 1 : 0;
+                                }
+                            });
+                independent.clear();
+                for (std::uint32_t node : remaining)
+                {
+                    if (picked[node])
+                    {
+                        independent.push_back(node);
+                        contracted[node] = 1; // Witness searches of this round must avoid the whole set.
+                    }
+                }
+
+                // 2. Simulate their contractions in parallel.
+                shortcuts.resize(independent.size());
+                parallelFor(independent.size(), options.threads, 16,
+                            [&](unsigned worker, std::size_t begin, std::size_t end)
+                            {
+                                for (std::size_t i = begin; i < end; ++i)
+                                {
+                                    shortcuts[i].clear();
+                                    simulate(independent[i], searches[worker], &shortcuts[i]);
+                                }
+                            });
+
+                // 3. Apply them: record the arcs of each node, drop it from the graph, add its shortcuts.
+                touched.clear();
+                for (std::size_t i = 0; i < independent.size(); ++i)
+                {
+                    std::uint32_t node = independent[i];
+                    ch.rank[node] = nextRank++;
+                    up[node] = outArcs[node];
+                    down[node] = inArcs[node];
+                    for (const HierarchyArc &arc : outArcs[node])
+                    {
+                        removeArc(inArcs[arc.target], node);
+                        markNeighbor(node, arc.target, touched, isTouched);
+                    }
+                    for (const HierarchyArc &arc : inArcs[node])
+                    {
+                        removeArc(outArcs[arc.target], node);
+                        markNeighbor(node, arc.target, touched, isTouched);
+                    }
+                    for (const Shortcut &shortcut : shortcuts[i])
+                    {
+                        addArc(shortcut.from, shortcut.to, shortcut.weight, shortcut.middle, true);
+                    }
+                    std::vector<HierarchyArc>().swap(outArcs[node]);
+                    std::vector<HierarchyArc>().swap(inArcs[node]);
+                }
+                remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                               [&](std::uint32_t node) { return contracted[node] != 0; }),
+                                remaining.end());
+
+                // 4. Neighbors lost an edge and may have gained shortcuts: refresh their priorities.
+                for (std::uint32_t node : touched)
+                {
+                    isTouched[node] = 0;
+                }
+                updatePriorities(touched);
+            }
+
+            ch.shortcutCount = shortcutTotal;
+            pack(up, ch.upOffsets, ch.upArcs);
+            pack(down, ch.downOffsets, ch.downArcs);
+            return ch;
+        }
+
+    private:
+        std::uint32_t nodeCount;
+        ContractionOptions options;
+        std::vector<std::vector<HierarchyArc>> outArcs;  ///< Remaining arcs leaving each node.
+        std::vector<std::vector<HierarchyArc>> inArcs;   ///< Remaining arcs entering each node (target = tail).
+        std::vector<std::uint8_t> contracted;            ///< 1 once a node is (being) contracted.
+        std::vector<std::uint32_t> deletedNeighbors;     ///< Contracted neighbors of each node.
+        std::vector<std::uint32_t> level;                ///< Hierarchy depth below each node.
+        std::vector<int> priority;                       ///< Lower = contracted earlier.
+        std::vector<std::vector<HierarchyArc>> up;       ///< Output up arcs of each contracted node.
+        std::vector<std::vector<HierarchyArc>> down;     ///< Output down arcs of each contracted node.
+        std::vector<WitnessSearch> searches;             ///< One witness search per thread.
+        std::uint32_t shortcutTotal = 0;
+
+        /**
+         * @brief Inserts arc from -> to, or shortens the existing one (parallel edges keep the shortest).
+         */
+        void addArc(std::uint32_t from, std::uint32_t to, float weight, std::uint32_t middle, bool isShortcut)
+        {
+            bool added = upsert(outArcs[from], to, weight, middle);
+            upsert(inArcs[to], from, weight, middle);
+            if (isShortcut && added)
+            {
+                shortcutTotal++;
+            }
+        }
+
+        static bool upsert(std::vector<HierarchyArc> &arcs, std::uint32_t target, float weight, std::uint32_t middle)
+        {
+            for (HierarchyArc &arc : arcs)
+            {
+                if (arc.target == target)
+                {
+                    if (weight < arc.weight)
+                    {
+                        arc.weight = weight;
+                        arc.middle = middle;
+                    }
+                    return false;
+                }
+            }
+            arcs.push_back({target, weight, middle});
+            return true;
+        }
+
+        static void removeArc(std::vector<HierarchyArc> &arcs, std::uint32_t target)
+        {
+            for (std::size_t i = 0; i < arcs.size(); ++i)
+            {
+                if (arcs[i].target == target)
+                {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+            }
+        }
+
+        void markNeighbor(std::uint32_t node, std::uint32_t neighbor, std::vector<std::uint32_t> &touched,
+                          std::vector<std::uint8_t> &isTouched)
+        {
+            deletedNeighbors[neighbor]++;
+            level[neighbor] = std::max(level[neighbor], level[node] + 1);
+            if (!isTouched[neighbor])
+            {
+                isTouched[neighbor] = 1;
+                touched.push_back(neighbor);
+            }
+        }
+
+        /**
+         * @brief Tells whether node has a smaller (priority, id) than every remaining neighbor.
+         */
+        bool isLocalMinimum(std::uint32_t node) const
+        {
+            auto beats = [&](std::uint32_t other)
+            {
+                return priority[node] < priority[other] || (priority[node] == priority[other] && node < other);
+            };
+            for (const HierarchyArc &arc : outArcs[node])
+            {
+                if (!beats(arc.target))
+                {
+                    return false;
+                }
+            }
+            for (const HierarchyArc &arc : inArcs[node])
+            {
+                if (!beats(arc.target))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Recomputes the priority of the given nodes in parallel.
+         *
+         * Priority = edge difference (shortcuts added - arcs removed) + contracted neighbors + level,
+         * which favors nodes whose removal keeps the graph small and spreads contraction evenly.
+         */
+        void updatePriorities(const std::vector<std::uint32_t> &nodes)
+        {
+            parallelFor(nodes.size(), options.threads, 64,
+                        [&](unsigned worker, std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                std::uint32_t node = nodes[i];
+                                int added = static_cast<int>(simulate(node, searches[worker], nullptr));
+                                int removed = static_cast<int>(outArcs[node].size() + inArcs[node].size());
+                                priority[node] = added - removed + static_cast<int>(deletedNeighbors[node]) +
+                                                 static_cast<int>(level[node]);
+                            }
+                        });
+        }
+
+        /**
+         * @brief Finds the shortcuts needed to contract node, without changing the graph.
+         *
+         * For every arc u -> node, a local Dijkstra from u over the remaining graph (skipping node and
+         * anything contracted) looks for a "witness" path to each w of node -> w that is no longer than
+         * u -> node -> w. Pairs without a witness need a shortcut. The search stops at the longest
+         * candidate length, once every w is settled, or after the settle limit (adding a few unneeded
+         * shortcuts is safe). Priority estimates use the smaller prioritySettleLimit: they only rank
+         * nodes, so a rough count is enough.
+         *
+         * @return The number of shortcuts; they are appended to out when it is not nullptr.
+         */
+        std::uint32_t simulate(std::uint32_t node, WitnessSearch &search, std::vector<Shortcut> *out) const
+        {
+            std::uint32_t count = 0;
+            for (const HierarchyArc &in : inArcs[node])
+            {
+                std::uint32_t source = in.target;
+                float limit = 0.0f;
+                bool anyTarget = false;
+                for (const HierarchyArc &outArc : outArcs[node])
+                {
+                    if (outArc.target != source)
+                    {
+                        limit = std::max(limit, in.weight + outArc.weight);
+                        anyTarget = true;
+                    }
+                }
+                if (!anyTarget)
+                {
+                    continue;
+                }
+
+                std::uint32_t targets = 0;
+                search.mark++;
+                for (const HierarchyArc &outArc : outArcs[node])
+                {
+                    if (outArc.target != source && search.targetMark[outArc.target] != search.mark)
+                    {
+                        search.targetMark[outArc.target] = search.mark;
+                        targets++;
+                    }
+                }
+                witness(search, source, node, limit, targets,
+                        out != nullptr ? options.witnessSettleLimit : options.prioritySettleLimit);
+                for (const HierarchyArc &outArc : outArcs[node])
+                {
+                    if (outArc.target == source)
+                    {
+                        continue;
+                    }
+                    float via = in.weight + outArc.weight;
+                    if (search.state.distance(outArc.target) > via)
+                    {
+                        count++;
+                        if (out != nullptr)
+                        {
+                            out->push_back({source, outArc.target, via, node});
+                        }
+                    }
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Bounded Dijkstra from source over remaining nodes, never entering skipped.
+         *
+         * Stops past limit, after settleLimit nodes, or once the targets marked in search are all settled.
+         */
+        void witness(WitnessSearch &search, std::uint32_t source, std::uint32_t skipped, float limit,
+                     std::uint32_t targets, std::uint32_t settleLimit) const
+        {
+            search.state.reset();
+            search.heap.clear();
+            search.state.reach(source, 0.0f, NO_NODE);
+            search.heap.push(source, 0.0f);
+            std::uint32_t settled = 0;
+            std::uint32_t current;
+            float key;
+            while (search.heap.pop(current, key))
+            {
+                if (key > limit || ++settled > settleLimit)
+                {
+                    break;
+                }
+                if (search.targetMark[current] == search.mark && --targets == 0)
+                {
+                    break;
+                }
+                for (const HierarchyArc &arc : outArcs[current])
+                {
+                    if (arc.target == skipped || contracted[arc.target])
+                    {
+                        continue;
+                    }
+                    float newDistance = key + arc.weight;
+                    if (newDistance < search.state.distance(arc.target))
+                    {
+                        search.state.reach(arc.target, newDistance, current);
+                        search.heap.push(arc.target, newDistance);
+                    }
+                }
+            }
+        }
+
+        void pack(std::vector<std::vector<HierarchyArc>> &lists, std::vector<std::uint32_t> &offsets,
+                  std::vector<HierarchyArc> &arcs) const
+        {
+            offsets.assign(static_cast<std::size_t>(nodeCount) + 1, 0);
+            for (std::uint32_t node = 0; node < nodeCount; ++node)
+            {
+                offsets[node + 1] = offsets[node] + static_cast<std::uint32_t>(lists[node].size());
+            }
+            arcs.clear();
+            arcs.reserve(offsets[nodeCount]);
+            for (std::vector<HierarchyArc> &list : lists)
+            {
+                arcs.insert(arcs.end(), list.begin(), list.end());
+                std::vector<HierarchyArc>().swap(list);
+            }
+        }
+    };
+};
+
+/**
+ * @brief Point-to-point query on a ContractionHierarchy.
+ *
+ * Runs a bidirectional Dijkstra where the forward search only follows up arcs from the source and the
+ * backward search only follows down arcs (backwards) from the target. Every shortest path has a
+ * highest-ranked node where the two upward searches meet, so the best meeting node gives the distance.
+ * Each side stops once its next key is not below the best meeting found.
+ *
+ * Stall-on-demand prunes nodes reached suboptimally: if a higher-ranked neighbor already offers a
+ * shorter way into a node, the node is not expanded.
+ *
+ * path() unpacks shortcuts back into original nodes.
+ *
+ * @tparam Frontier Heap used by both sides.
+ */
+template <typename Frontier = BinaryHeap>
+class HierarchyQuery
+{
+public:
+    /**
+     * @brief Creates a query engine. The hierarchy must outlive it.
+     */
+    explicit HierarchyQuery(const ContractionHierarchy &hierarchy)
+        : ch(hierarchy), sides{Side(hierarchy.nodeCount()), Side(hierarchy.nodeCount())}
+    {
+    }
+
+    /**
+     * @brief Computes the shortest distance from source to target.
+     *
+     * @return The distance, or INFINITY_VALUE if target cannot be reached.
+     */
+    float run(std::uint32_t source, std::uint32_t target)
+    {
+        startNode = source;
+        endNode = target;
+        best = INFINITY_VALUE;
+        meeting = NO_NODE;
+        settledNodes = 0;
+        for (Side &side : sides)
+        {
+            side.state.reset();
+            side.frontier.clear();
+        }
+        sides[FORWARD].state.reach(source, 0.0f, NO_NODE);
+        sides[FORWARD].frontier.push(source, 0.0f);
+        sides[BACKWARD].state.reach(target, 0.0f, NO_NODE);
+        sides[BACKWARD].frontier.push(target, 0.0f);
+        if (source == target)
+        {
+            best = 0.0f;
+            meeting = source;
+            return best;
+        }
+
+        while (true)
+        {
+            bool forwardOpen = !sides[FORWARD].frontier.empty() && sides[FORWARD].frontier.top().key < best;
+            bool backwardOpen = !sides[BACKWARD].frontier.empty() && sides[BACKWARD].frontier.top().key < best;
+            if (!forwardOpen && !backwardOpen)
+            {
+                break;
+            }
+            if (forwardOpen && (!backwardOpen || sides[FORWARD].frontier.top().key <= sides[BACKWARD].frontier.top().key))
+            {
+                step(FORWARD);
+            }
+            else
+            {
+                step(BACKWARD);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Distance found by the last run, or INFINITY_VALUE.
+     */
+    float distance() const { return best; }
+
+    /**
+     * @brief Nodes settled by both sides during the last run.
+     */
+    std::uint32_t settledCount() const { return settledNodes; }
+
+    /**
+     * @brief Shortest path of the last run in original nodes, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path() const
+    {
+        std::vector<std::uint32_t> result;
+        if (meeting == NO_NODE)
+        {
+            return result;
+        }
+        // Upward chain source -> meeting, read backwards from the forward predecessors.
+        std::vector<std::uint32_t> upChain;
+        for (std::uint32_t node = meeting; node != NO_NODE; node = sides[FORWARD].state.predecessor(node))
+        {
+            upChain.push_back(node);
+        }
+        std::reverse(upChain.begin(), upChain.end());
+        result.push_back(startNode);
+        for (std::size_t i = 0; i + 1 < upChain.size(); ++i)
+        {
+            ch.unpack(upChain[i], upChain[i + 1], ch.findUp(upChain[i], upChain[i + 1])->middle, result);
+        }
+        // Downward chain meeting -> target, following the backward predecessors.
+        for (std::uint32_t node = meeting; node != endNode;)
+        {
+            std::uint32_t next = sides[BACKWARD].state.predecessor(node);
+            ch.unpack(node, next, ch.findDown(node, next)->middle, result);
+            node = next;
+        }
+        return result;
+    }
+
+private:
+    static constexpr int FORWARD = 0;
+    static constexpr int BACKWARD = 1;
+
+    struct Side
+    {
+        Frontier frontier;
+        QueryContext state;
+
+        explicit Side(std::uint32_t nodeCount) : frontier(nodeCount), state(nodeCount) {}
+    };
+
+    const ContractionHierarchy &ch;    ///< Preprocessed graph.
+    Side sides[2];                     ///< Upward searches from source and target.
+    std::uint32_t startNode = NO_NODE; ///< Source of the last run.
+    std::uint32_t endNode = NO_NODE;   ///< Target of the last run.
+    float best = INFINITY_VALUE;       ///< Best source-target distance seen.
+    std::uint32_t meeting = NO_NODE;   ///< Node where the best path peaks.
+    std::uint32_t settledNodes = 0;    ///< Nodes settled by both sides.
+
+    void step(int direction)
+    {
+        Side &side = sides[direction];
+        const QueryContext &other = sides[1 - direction].state;
+        // Forward search climbs up arcs; backward search climbs down arcs (stored at the lower end).
+        const std::vector<std::uint32_t> &offsets = direction == FORWARD ? ch.upOffsets : ch.downOffsets;
+        const std::vector<HierarchyArc> &arcs = direction == FORWARD ? ch.upArcs : ch.downArcs;
+        const std::vector<std::uint32_t> &stallOffsets = direction == FORWARD ? ch.downOffsets : ch.upOffsets;
+        const std::vector<HierarchyArc> &stallArcs = direction == FORWARD ? ch.downArcs : ch.upArcs;
+
+        std::uint32_t current = NO_NODE;
+        float key = 0.0f;
+        side.frontier.pop(current, key);
+        if (side.state.isSettled(current))
+        {
+            return; // Outdated copy left behind by a lazy heap.
+        }
+        side.state.settle(current);
+        settledNodes++;
+        if (other.reached(current) && key + other.distance(current) < best)
+        {
+            best = key + other.distance(current);
+            meeting = current;
+        }
+
+        // Stall-on-demand: a higher node reaching current more cheaply means current is not on a shortest up-path.
+        for (std::uint32_t i = stallOffsets[current]; i < stallOffsets[current + 1]; ++i)
+        {
+            if (side.state.distance(stallArcs[i].target) + stallArcs[i].weight < key)
+            {
+                return;
+            }
+        }
+
+        for (std::uint32_t i = offsets[current]; i < offsets[current + 1]; ++i)
+        {
+            std::uint32_t next = arcs[i].target;
+            float newDistance = key + arcs[i].weight;
+            if (!side.state.isSettled(next) && newDistance < side.state.distance(next))
+            {
+                side.state.reach(next, newDistance, current);
+                side.frontier.push(next, newDistance);
+                if (other.reached(next) && newDistance + other.distance(next) < best)
+                {
+                    best = newDistance + other.distance(next);
+                    meeting = next;
+                }
+            }
+        }
+    }
+};
+
+#endif // CONTRACTION_HIERARCHY_HPP_
@@ -0,0 +1,287 @@
+#ifndef CSR_DIJKSTRA_HPP_
+#define CSR_DIJKSTRA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+#include "query_context.hpp"
+#include "relax_kernels.hpp"
+#include "tracing.hpp"
+
+/**
+ * @brief A node settled by a search, with its final distance.
+ */
+struct ReachedNode
+{
+    std::uint32_t node; ///< Node id.
+    float distance;     ///< Shortest distance from the source.
+};
+
+/**
+ * @brief Dijkstra's algorithm running directly on a CSR graph.
+ *
+ * Same algorithm as the Dijkstra class (same relaxation, same early stop at the destination, same
+ * tie-breaking), but every per-node lookup is an array index: distances, predecessors and the settled
+ * flags live in a QueryContext indexed by the dense node id, and neighbors come from the packed CSR rows.
+ *
+ * The engine only keeps a view of the graph, so several engines can share one graph without copying it.
+ * Its context and heap are sized once; after that, back-to-back runs do not allocate and only touch the
+ * nodes they reach. pathInto() writes a route into a caller-owned buffer in forward order, so answering
+ * a query end to end involves no heap traffic at all.
+ *
+ * runWithin() is the bounded (isochrone) mode: it settles every node whose distance is within a budget and
+ * stops as soon as the frontier minimum exceeds it. Because starting a query is O(1) (see QueryContext)
+ * its cost depends only on the ball it explores, not on the size of the graph.
+ *
+ * With TrackPaths = false (DistanceOnlyDijkstra) predecessors are neither allocated nor written; only
+ * distances are kept, and the path functions do not compile.
+ *
+ * Rows of at least SIMD_MIN_DEGREE edges are screened a block at a time by the AVX2 / AVX-512 kernels of
+ * relax_kernels.hpp (picked for the running CPU) before the per-edge test, with the same updates and
+ * pushes as the scalar loop. Traced engines always use the scalar loop, so every relaxation is reported.
+ *
+ * @tparam Frontier One of the heaps from indexed_heap.hpp.
+ * @tparam Trace Tracing policy from tracing.hpp (ConsoleTrace prints the selected nodes only).
+ * @tparam TrackPaths Whether predecessors are recorded.
+ */
+template <typename Frontier = BinaryHeap, typename Trace = NoTrace, bool TrackPaths = true>
+class CsrDijkstra
+{
+public:
+    /**
+     * @brief Creates an engine for the given graph. The graph must outlive the engine.
+     */
+    explicit CsrDijkstra(CsrView g) : graph(g), frontier(g.nodeCount), state(g.nodeCount, TrackPaths) {}
+
+    /**
+     * @brief Computes shortest paths from source.
+     *
+     * Stops as soon as target is settled; with target == NO_NODE the whole reachable graph is settled.
+     *
+     * @param source Starting node.
+     * @param target Destination node, or NO_NODE for a full shortest-path tree.
+     */
+    void run(std::uint32_t source, std::uint32_t target = NO_NODE)
+    {
+        search(source, target, INFINITY_VALUE, [](std::uint32_t, float) {});
+    }
+
+    /**
+     * @brief Settles every node at distance <= budget from source, and nothing else.
+     *
+     * The search stops when the smallest key left in the frontier exceeds the budget. Nodes are appended
+     * to ball in the order they are settled, that is by non-decreasing distance, so the ring between two
+     * budgets is a contiguous range. distance(), predecessor() and path() are final for every node of the
+     * ball; nodes just outside it may still hold a tentative distance above the budget
+     * (context().isSettled() tells them apart).
+     *
+     * @param source Starting node.
+     * @param budget Largest distance kept (e.g. the travel-time limit of a service area).
+     * @param ball Cleared, then filled with the settled nodes. Reuse it across calls to avoid allocating.
+     * @return Number of nodes in the ball.
+     */
+    std::uint32_t runWithin(std::uint32_t source, float budget, std::vector<ReachedNode> &ball)
+    {
+        ball.clear();
+        search(source, NO_NODE, budget, [&](std::uint32_t node, float distance) { ball.push_back({node, distance}); });
+        return settledNodes;
+    }
+
+    /**
+     * @brief Distance from the last source, or INFINITY_VALUE if the node was not reached.
+     */
+    float distance(std::uint32_t node) const { return state.distance(node); }
+
+    /**
+     * @brief Previous node on the shortest path to node, or NO_NODE.
+     */
+    std::uint32_t predecessor(std::uint32_t node) const { return state.predecessor(node); }
+
+    /**
+     * @brief Number of nodes settled by the last run.
+     */
+    std::uint32_t settledCount() const { return settledNodes; }
+
+    /**
+     * @brief Search state of the last run (distances, predecessors, reached nodes).
+     */
+    const QueryContext &context() const { return state; }
+
+    /**
+     * @brief Instruction set used to relax high-degree rows (detected at construction).
+     */
+    SimdLevel simdLevel() const { return simd; }
+
+    /**
+     * @brief Overrides the detected instruction set, e.g. SimdLevel::Scalar to compare against the plain loop.
+     *        Levels the CPU does not support must not be set.
+     */
+    void setSimdLevel(SimdLevel level) { simd = level; }
+
+    /**
+     * @brief The tracing policy instance, to read its counters or events after a run.
+     */
+    Trace &tracer() { return trace; }
+    const Trace &tracer() const { return trace; }
+
+    /**
+     * @brief Shortest path from the last source to target, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t target) const
+    {
+        std::vector<std::uint32_t> result;
+        pathInto(target, result);
+        return result;
+    }
+
+    /**
+     * @brief Writes the shortest path to target into out[0, length), source first, without allocating.
+     *
+     * @return The path length, 0 if there is none. If it is larger than capacity nothing is written.
+     */
+    std::size_t pathInto(std::uint32_t target, std::uint32_t *out, std::size_t capacity) const
+    {
+        static_assert(TrackPaths, "A distance-only engine keeps no paths.");
+        return state.writePath(target, out, capacity);
+    }
+
+    /**
+     * @brief Writes the shortest path to target into a reusable vector (emptied if there is none).
+     */
+    void pathInto(std::uint32_t target, std::vector<std::uint32_t> &out) const
+    {
+        static_assert(TrackPaths, "A distance-only engine keeps no paths.");
+        state.writePath(target, out);
+    }
+
+private:
+    CsrView graph;                      ///< Graph being searched.
+    Frontier frontier;                  ///< Queue of reached, unsettled nodes.
+    QueryContext state;                 ///< Reusable per-node distances, predecessors and flags.
+    std::uint32_t startNode = NO_NODE;  ///< Source of the last run.
+    std::uint32_t settledNodes = 0;     ///< Nodes settled by the last run.
+    Trace trace;                        ///< Receives the steps of every run.
+    SimdLevel simd = detectSimdLevel(); ///< Kernel for rows of SIMD_MIN_DEGREE edges or more.
+
+    static constexpr std::uint32_t SIMD_MIN_DEGREE = 16; ///< Shorter rows are not worth the gathers.
+    static constexpr bool USE_SIMD = std::is_same<Trace, NoTrace>::value; ///< Vector rows skip trace.relax().
+
+    /**
+     * @brief Main loop shared by run() and runWithin(): settles nodes up to target or up to budget.
+     */
+    template <typename OnSettle>
+    void search(std::uint32_t source, std::uint32_t target, float budget, OnSettle &&onSettle)
+    {
+        state.reset();
+        frontier.clear();
+        settledNodes = 0;
+        startNode = source;
+
+        record(source, 0.0f, NO_NODE);
+        frontier.push(source, 0.0f);
+
+        std::uint32_t current;
+        float key;
+        while (frontier.pop(current, key))
+        {
+            trace.pop(current, key);
+            if (key > budget)
+            {
+                break; // Everything still queued is at least this far.
+            }
+            if (state.isSettled(current))
+            {
+                continue; // Outdated copy left behind by a lazy heap.
+            }
+            state.settle(current);
+            settledNodes++;
+            trace.iteration(settledNodes, current);
+            onSettle(current, key);
+            if (current == target)
+            {
+                trace.reachedTarget(current);
+                break;
+            }
+            relax(current);
+        }
+        trace.finished(settledNodes);
+    }
+
+    /**
+     * @brief Stores a better distance, and the predecessor unless the engine is distance-only.
+     */
+    void record(std::uint32_t node, float distance, std::uint32_t predecessor)
+    {
+        if constexpr (TrackPaths)
+        {
+            state.reach(node, distance, predecessor);
+        }
+        else
+        {
+            state.reachDistance(node, distance);
+        }
+    }
+
+    /**
+     * @brief Relaxes every outgoing edge of a settled node.
+     */
+    void relax(std::uint32_t current)
+    {
+        const float base = state.distance(current);
+        std::uint32_t edge = graph.firstEdge(current);
+        const std::uint32_t last = graph.lastEdge(current);
+        if (USE_SIMD && simd != SimdLevel::Scalar && last - edge >= SIMD_MIN_DEGREE)
+        {
+            // Only the edges a block kernel flags go through the per-edge test (see relax_kernels.hpp).
+            const std::uint32_t width = relaxBlockWidth(simd);
+            for (; last - edge >= width; edge += width)
+            {
+                std::uint32_t flagged = improvingEdges(simd, graph.targets + edge, graph.weights + edge, base,
+                                                       state.distanceData(), state.stampData(), state.currentStamp());
+                for (std::uint32_t lane = 0; flagged != 0; ++lane, flagged >>= 1)
+                {
+                    if (flagged & 1u)
+                    {
+                        relaxEdge(current, base, edge + lane);
+                    }
+                }
+            }
+        }
+        for (; edge < last; ++edge)
+        {
+            relaxEdge(current, base, edge);
+        }
+    }
+
+    /**
+     * @brief Relaxes one edge of a settled node whose distance is base.
+     */
+    void relaxEdge(std::uint32_t current, float base, std::uint32_t edge)
+    {
+        std::uint32_t next = graph.targets[edge];
+        if (state.isSettled(next))
+        {
+            return;
+        }
+        float newDistance = base + graph.weights[edge];
+        trace.relax(current, next, newDistance);
+        if (newDistance < state.distance(next))
+        {
+            trace.decrease(next, newDistance);
+            record(next, newDistance, current);
+            frontier.push(next, newDistance);
+        }
+    }
+};
+
+/**
+ * @brief CsrDijkstra that only computes distances (no predecessor array, no path output).
+ */
+template <typename Frontier = BinaryHeap, typename Trace = NoTrace>
+using DistanceOnlyDijkstra = CsrDijkstra<Frontier, Trace, false>;
+
+#endif // CSR_DIJKSTRA_HPP_
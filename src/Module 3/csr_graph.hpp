@@ -0,0 +1,238 @@
+#ifndef CSR_GRAPH_HPP_
+#define CSR_GRAPH_HPP_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/**
+ * @brief Marker for "no node" (unreached predecessor, missing label, open-ended query...).
+ */
+constexpr std::uint32_t NO_NODE = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Directed, weighted edge given to the CSR builder.
+ */
+struct Edge
+{
+    std::uint32_t from; ///< Tail node.
+    std::uint32_t to;   ///< Head node.
+    float weight;       ///< Travel cost.
+};
+
+/**
+ * @brief Position of a node in the plane (the same x/y model as the Punto class of Module 3).
+ */
+struct Coordinate
+{
+    double x; ///< Horizontal coordinate.
+    double y; ///< Vertical coordinate.
+};
+
+/**
+ * @brief Read-only view of a graph in compressed sparse row (CSR) form.
+ *
+ * Nodes are dense integers in [0, nodeCount). The outgoing edges of node u are the slots
+ * [offsets[u], offsets[u + 1]) of the packed targets/weights arrays, so walking the neighbors of a node
+ * is a sequential scan of two arrays instead of a tree lookup followed by a pointer chase.
+ *
+ * A view does not own its arrays. It is cheap to copy and lets any number of engines share one graph.
+ */
+struct CsrView
+{
+    std::uint32_t nodeCount = 0;             ///< Number of nodes.
+    std::uint32_t edgeCount = 0;             ///< Number of edges.
+    const std::uint32_t *offsets = nullptr;  ///< nodeCount + 1 row offsets.
+    const std::uint32_t *targets = nullptr;  ///< edgeCount head nodes.
+    const float *weights = nullptr;          ///< edgeCount edge costs.
+    const Coordinate *coordinates = nullptr; ///< nodeCount positions, or nullptr if nodes have none.
+
+    std::uint32_t firstEdge(std::uint32_t node) const { return offsets[node]; }
+    std::uint32_t lastEdge(std::uint32_t node) const { return offsets[node + 1]; }
+    std::uint32_t degree(std::uint32_t node) const { return offsets[node + 1] - offsets[node]; }
+};
+
+/**
+ * @brief Graph stored in compressed sparse row form, owning its arrays.
+ *
+ * Built from an edge list or from the map<char, vector<Point>> literal used by the Dijkstra class.
+ * When built from characters, labels keeps the character of every dense id so results can be printed
+ * the same way as before.
+ */
+class CsrGraph
+{
+public:
+    std::vector<std::uint32_t> offsets;  ///< nodeCount + 1 row offsets.
+    std::vector<std::uint32_t> targets;  ///< Head node of every edge, grouped by tail node.
+    std::vector<float> weights;          ///< Cost of every edge, parallel to targets.
+    std::vector<char> labels;            ///< Character name of every node (empty for numeric graphs).
+    std::vector<Coordinate> coordinates; ///< Position of every node (empty if nodes have none).
+    std::uint64_t version = 0;           ///< Bumped by every setWeight(), so caches can spot stale results.
+
+    std::uint32_t nodeCount() const { return offsets.empty() ? 0 : static_cast<std::uint32_t>(offsets.size() - 1); }
+    std::uint32_t edgeCount() const { return static_cast<std::uint32_t>(targets.size()); }
+
+    /**
+     * @brief Returns a non-owning view over the arrays. It stays valid while the graph is alive and unchanged.
+     */
+    CsrView view() const
+    {
+        CsrView v;
+        v.nodeCount = nodeCount();
+        v.edgeCount = edgeCount();
+        v.offsets = offsets.data();
+        v.targets = targets.data();
+        v.weights = weights.data();
+        v.coordinates = coordinates.empty() ? nullptr : coordinates.data();
+        return v;
+    }
+
+    /**
+     * @brief Changes the cost of an edge (by CSR slot) and bumps the graph version.
+     */
+    void setWeight(std::uint32_t edge, float weight)
+    {
+        weights[edge] = weight;
+        ++version;
+    }
+
+    /**
+     * @brief Dense id of a character label, or NO_NODE if the graph has no such node.
+     */
+    std::uint32_t idOf(char label) const
+    {
+        for (std::uint32_t id = 0; id < labels.size(); ++id)
+        {
+            if (labels[id] == label)
+            {
+                return id;
+            }
+        }
+        return NO_NODE;
+    }
+};
+
+/**
+ * @brief Builds a CSR graph from an edge list.
+ *
+ * Edges are bucketed by tail node with a counting sort, keeping their input order inside each row.
+ *
+ * @param nodeCount Number of nodes; every endpoint must be smaller than it.
+ * @param edges Directed edges.
+ * @return The packed graph.
+ */
+inline CsrGraph buildCsrGraph(std::uint32_t nodeCount, const std::vector<Edge> &edges)
+{
+    CsrGraph g;
+    g.offsets.assign(static_cast<std::size_t>(nodeCount) + 1, 0);
+    for (const Edge &edge : edges)
+    {
+        g.offsets[edge.from + 1]++;
+    }
+    for (std::uint32_t node = 0; node < nodeCount; ++node)
+    {
+        g.offsets[node + 1] += g.offsets[node];
+    }
+    g.targets.resize(edges.size());
+    g.weights.resize(edges.size());
+    std::vector<std::uint32_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+    for (const Edge &edge : edges)
+    {
+        std::uint32_t slot = cursor[edge.from]++;
+        g.targets[slot] = edge.to;
+        g.weights[slot] = edge.weight;
+    }
+    return g;
+}
+
+/**
+ * @brief Builds the reverse graph: every edge u -> v becomes v -> u with the same weight.
+ *
+ * Searching the reverse graph from a node walks the original edges backwards, which is what backward
+ * searches (bidirectional queries, "distance to" tables) need.
+ *
+ * @param g Graph to reverse.
+ * @return The reversed graph (without labels, with the same coordinates).
+ */
+inline CsrGraph reverseGraph(CsrView g)
+{
+    CsrGraph r;
+    if (g.coordinates != nullptr)
+    {
+        r.coordinates.assign(g.coordinates, g.coordinates + g.nodeCount);
+    }
+    r.offsets.assign(static_cast<std::size_t>(g.nodeCount) + 1, 0);
+    for (std::uint32_t edge = 0; edge < g.edgeCount; ++edge)
+    {
+        r.offsets[g.targets[edge] + 1]++;
+    }
+    for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+    {
+        r.offsets[node + 1] += r.offsets[node];
+    }
+    r.targets.resize(g.edgeCount);
+    r.weights.resize(g.edgeCount);
+    std::vector<std::uint32_t> cursor(r.offsets.begin(), r.offsets.end() - 1);
+    for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+    {
+        for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+        {
+            std::uint32_t slot = cursor[g.targets[edge]]++;
+            r.targets[slot] = node;
+            r.weights[slot] = g.weights[edge];
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Builds a CSR graph from the map<char, vector<Point>> form used by the Dijkstra class.
+ *
+ * Every character that appears (as a key or as a neighbor) gets a dense id, in increasing character
+ * order. That keeps the tie-breaking of the heap frontiers identical to the reference class.
+ *
+ * @param graph Graph literal: each node maps to its connections (neighbor and cost).
+ * @return The packed graph, with labels filled in.
+ */
+inline CsrGraph buildCsrGraph(const std::map<char, std::vector<Point>> &graph)
+{
+    std::set<char> names;
+    for (const auto &node : graph)
+    {
+        names.insert(node.first);
+        for (const Point &connection : node.second)
+        {
+            names.insert(connection.node);
+        }
+    }
+
+    std::array<std::uint32_t, std::numeric_limits<unsigned char>::max() + 1> idByLabel;
+    idByLabel.fill(NO_NODE);
+    std::vector<char> labels(names.begin(), names.end());
+    for (std::uint32_t id = 0; id < labels.size(); ++id)
+    {
+        idByLabel[static_cast<unsigned char>(labels[id])] = id;
+    }
+
+    std::vector<Edge> edges;
+    for (const auto &node : graph)
+    {
+        for (const Point &connection : node.second)
+        {
+            edges.push_back({idByLabel[static_cast<unsigned char>(node.first)],
+                             idByLabel[static_cast<unsigned char>(connection.node)], connection.distance});
+        }
+    }
+
+    CsrGraph g = buildCsrGraph(static_cast<std::uint32_t>(labels.size()), edges);
+    g.labels = std::move(labels);
+    return g;
+}
+
+#endif // CSR_GRAPH_HPP_
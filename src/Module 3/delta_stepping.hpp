@@ -0,0 +1,340 @@
+#ifndef DELTA_STEPPING_HPP_
+#define DELTA_STEPPING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief Parallel single-source shortest paths by delta-stepping (Meyer and Sanders).
+ *
+ * Tentative distances are grouped in buckets of width delta; bucket i holds nodes whose distance lies
+ * in [i * delta, (i + 1) * delta). Buckets are emptied in increasing order. Edges are split into light
+ * (weight <= delta) and heavy ones: light edges can land back in the current bucket, so the bucket is
+ * relaxed repeatedly until it stays empty, and only then are the heavy edges of everything it held
+ * relaxed once, with final distances. Every phase relaxes a whole frontier in parallel, on worker threads
+ * that the engine starts once and keeps parked between phases and runs.
+ *
+ * Distances and predecessors are packed in one 64-bit word per node and lowered with compare-and-swap,
+ * so concurrent relaxations need no locks. The resulting distances are bit-for-bit those of a
+ * sequential Dijkstra (CsrDijkstra), whatever delta and the thread count: both compute, for every node,
+ * the smallest of d(u) + w(u, v) over its final in-neighbor distances. Among equally short ways in,
+ * the predecessor with the smallest id wins, so predecessors do not depend on the thread count either
+ * (only zero-length ties between nodes of equal distance are left to the first one found).
+ *
+ * Small delta means little wasted work but many phases; large delta means few phases, more
+ * re-relaxations (delta = infinity is Bellman-Ford). The default is the maximum edge weight divided by
+ * the average out-degree.
+ */
+class DeltaStepping
+{
+public:
+    /**
+     * @brief Creates the engine and its worker threads. The graph must outlive it.
+     *
+     * @param g Graph to search (weights must be non-negative).
+     * @param bucketWidth Delta, or 0 to pick one from the graph.
+     * @param threads Worker threads (0 = one per hardware thread).
+     */
+    explicit DeltaStepping(CsrView g, float bucketWidth = 0.0f, unsigned threads = 0)
+        : graph(g), pool(threads), labels(g.nodeCount), queuedKey(g.nodeCount), expandedRound(g.nodeCount, 0),
+          improved(pool.threadCount()), expanded(pool.threadCount())
+    {
+        float maxWeight = 0.0f;
+        for (std::uint32_t edge = 0; edge < g.edgeCount; ++edge)
+        {
+            maxWeight = std::max(maxWeight, g.weights[edge]);
+        }
+        if (bucketWidth <= 0.0f)
+        {
+            float averageDegree =
+                g.nodeCount == 0 ? 1.0f : static_cast<float>(g.edgeCount) / static_cast<float>(g.nodeCount);
+            bucketWidth = maxWeight / std::max(averageDegree, 1.0f);
+        }
+        // Keep the cyclic bucket array at a sane size (and delta positive on all-zero weights).
+        width = std::max(bucketWidth, std::max(maxWeight / MAX_BUCKETS, 1e-6f));
+        buckets.resize(static_cast<std::size_t>(maxWeight / width) + 3); // +1 spare slot for rounding.
+    }
+
+    /**
+     * @brief Bucket width (delta) in use.
+     */
+    float delta() const { return width; }
+
+    /**
+     * @brief Computes the shortest-path tree from source to every reachable node.
+     */
+    void run(std::uint32_t source)
+    {
+        phases = 0;
+        reachedNodes = 0;
+        pool.parallelFor(graph.nodeCount, 4096,
+                         [&](unsigned, std::size_t begin, std::size_t end)
+                         {
+                             for (std::size_t node = begin; node < end; ++node)
+                             {
+                                 labels[node].store(UNREACHED, std::memory_order_relaxed);
+                                 queuedKey[node] = UNREACHED_KEY;
+                                 expandedRound[node] = 0;
+                             }
+                         });
+        for (std::vector<BucketEntry> &bucket : buckets)
+        {
+            bucket.clear();
+        }
+        pending = 0;
+
+        labels[source].store(pack(0.0f, NO_NODE), std::memory_order_relaxed);
+        enqueue(source, 0.0f);
+
+        std::vector<BucketEntry> frontier;
+        std::vector<std::uint32_t> settled;
+        std::uint32_t round = 0; // Marks nodes expanded from the current bucket (0 means never).
+        for (std::uint64_t index = 0; pending > 0; ++index)
+        {
+            std::vector<BucketEntry> &bucket = buckets[index % buckets.size()];
+            if (bucket.empty())
+            {
+                continue;
+            }
+            round++;
+            settled.clear();
+
+            // Light phases: relax light edges until no node falls back into this bucket.
+            while (!bucket.empty())
+            {
+                frontier.swap(bucket);
+                bucket.clear();
+                pending -= frontier.size();
+                phases++;
+                pool.parallelFor(frontier.size(), GRAIN,
+                                 [&](unsigned worker, std::size_t begin, std::size_t end)
+                                 {
+                                     for (std::size_t i = begin; i < end; ++i)
+                                     {
+                                         const BucketEntry &entry = frontier[i];
+                                         if (entry.distance != distance(entry.node))
+                                         {
+                                             continue; // Superseded by a shorter distance.
+                                         }
+                                         if (expandedRound[entry.node] != round)
+                                         {
+                                             expandedRound[entry.node] = round;
+                                             expanded[worker].push_back(entry.node);
+                                         }
+                                         relaxEdges(worker, entry.node, entry.distance, true);
+                                     }
+                                 });
+                collect(settled);
+            }
+
+            // Heavy phase: distances of the bucket are final, relax their heavy edges once.
+            phases++;
+            pool.parallelFor(settled.size(), GRAIN,
+                             [&](unsigned worker, std::size_t begin, std::size_t end)
+                             {
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     relaxEdges(worker, settled[i], distance(settled[i]), false);
+                                 }
+                             });
+            collect(settled);
+            reachedNodes += static_cast<std::uint32_t>(settled.size()); // A node is final in one bucket only.
+        }
+    }
+
+    /**
+     * @brief Distance from the last source, or INFINITY_VALUE if the node was not reached.
+     */
+    float distance(std::uint32_t node) const { return distanceOf(labels[node].load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Previous node on the shortest path to node, or NO_NODE.
+     */
+    std::uint32_t predecessor(std::uint32_t node) const
+    {
+        return static_cast<std::uint32_t>(labels[node].load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Distances of every node from the last source (INFINITY_VALUE where unreachable).
+     */
+    std::vector<float> distances() const
+    {
+        std::vector<float> result(graph.nodeCount);
+        for (std::uint32_t node = 0; node < graph.nodeCount; ++node)
+        {
+            result[node] = distance(node);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Shortest path from the last source to target, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t target) const
+    {
+        std::vector<std::uint32_t> result;
+        if (distance(target) == INFINITY_VALUE)
+        {
+            return result;
+        }
+        for (std::uint32_t node = target; node != NO_NODE; node = predecessor(node))
+        {
+            result.push_back(node);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Parallel relaxation phases (light and heavy) used by the last run.
+     */
+    std::uint32_t phaseCount() const { return phases; }
+
+    /**
+     * @brief Nodes reached (and settled) by the last run, the source included.
+     */
+    std::uint32_t reachedCount() const { return reachedNodes; }
+
+private:
+    static constexpr std::size_t GRAIN = 256;        ///< Frontier nodes per parallel chunk.
+    static constexpr float MAX_BUCKETS = 1 << 20;    ///< Upper bound on maxWeight / delta.
+    static constexpr std::uint32_t UNREACHED_KEY = 0xFFFFFFFFu; ///< Not a valid distance bit pattern.
+    static constexpr std::uint64_t UNREACHED = (std::uint64_t(0x7F7FFFFFu) << 32) | NO_NODE; ///< (INFINITY_VALUE, NO_NODE).
+
+    /**
+     * @brief Node waiting in a bucket with the distance it was queued with.
+     */
+    struct BucketEntry
+    {
+        std::uint32_t node;
+        float distance;
+    };
+
+    CsrView graph;                                    ///< Graph being searched.
+    ThreadPool pool;                                  ///< Workers of every phase, parked in between.
+    float width = 1.0f;                               ///< Bucket width (delta).
+    std::vector<std::atomic<std::uint64_t>> labels;   ///< Distance bits (high) and predecessor (low).
+    std::vector<std::uint32_t> queuedKey;             ///< Distance bits each node was last queued with.
+    std::vector<std::uint32_t> expandedRound;         ///< Last bucket round that expanded each node.
+    std::vector<std::vector<BucketEntry>> buckets;    ///< Cyclic array of buckets.
+    std::size_t pending = 0;                          ///< Entries over all buckets.
+    std::vector<std::vector<std::uint32_t>> improved; ///< Nodes whose distance dropped, per worker.
+    std::vector<std::vector<std::uint32_t>> expanded; ///< Nodes expanded from the current bucket, per worker.
+    std::uint32_t phases = 0;                         ///< Phases of the last run.
+    std::uint32_t reachedNodes = 0;                   ///< Nodes settled by the last run.
+
+    static std::uint32_t bitsOf(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static std::uint64_t pack(float distance, std::uint32_t predecessor)
+    {
+        return (std::uint64_t(bitsOf(distance)) << 32) | predecessor;
+    }
+
+    static float distanceOf(std::uint64_t label)
+    {
+        std::uint32_t bits = static_cast<std::uint32_t>(label >> 32);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Lowers the label of next to (newDistance, from) if that is better.
+     *
+     * A tie on distance goes to the smaller predecessor id, unless the edge did not change the distance
+     * at all (zero-length or absorbed by rounding), which could otherwise close a predecessor cycle.
+     *
+     * @return true if the distance itself dropped, so the node has to be (re)queued.
+     */
+    bool lower(std::uint32_t next, float newDistance, std::uint32_t from, bool tieAllowed)
+    {
+        std::atomic<std::uint64_t> &label = labels[next];
+        std::uint64_t candidate = pack(newDistance, from);
+        std::uint64_t current = label.load(std::memory_order_relaxed);
+        while (true)
+        {
+            float currentDistance = distanceOf(current);
+            bool shorter = newDistance < currentDistance;
+            if (!shorter && !(tieAllowed && newDistance == currentDistance && from < static_cast<std::uint32_t>(current)))
+            {
+                return false;
+            }
+            if (label.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                return shorter;
+            }
+        }
+    }
+
+    /**
+     * @brief Relaxes the light (or heavy) edges of node at the given distance.
+     */
+    void relaxEdges(unsigned worker, std::uint32_t node, float base, bool light)
+    {
+        for (std::uint32_t edge = graph.firstEdge(node); edge < graph.lastEdge(node); ++edge)
+        {
+            float weight = graph.weights[edge];
+            if ((weight <= width) != light)
+            {
+                continue;
+            }
+            float newDistance = base + weight;
+            if (lower(graph.targets[edge], newDistance, node, newDistance > base))
+            {
+                improved[worker].push_back(graph.targets[edge]);
+            }
+        }
+    }
+
+    /**
+     * @brief Queues the nodes improved by the last phase and gathers the nodes it expanded.
+     */
+    void collect(std::vector<std::uint32_t> &settled)
+    {
+        for (std::vector<std::uint32_t> &list : improved)
+        {
+            for (std::uint32_t node : list)
+            {
+                enqueue(node, distance(node));
+            }
+            list.clear();
+        }
+        for (std::vector<std::uint32_t> &list : expanded)
+        {
+            settled.insert(settled.end(), list.begin(), list.end());
+            list.clear();
+        }
+    }
+
+    /**
+     * @brief Puts node in the bucket of its distance, unless it already waits there with that distance.
+     */
+    void enqueue(std::uint32_t node, float nodeDistance)
+    {
+        std::uint32_t key = bitsOf(nodeDistance);
+        if (queuedKey[node] == key)
+        {
+            return;
+        }
+        queuedKey[node] = key;
+        double bucket = static_cast<double>(nodeDistance) / static_cast<double>(width);
+        std::uint64_t index = static_cast<std::uint64_t>(bucket);
+        buckets[index % buckets.size()].push_back({node, nodeDistance});
+        pending++;
+    }
+};
+
+#endif // DELTA_STEPPING_HPP_
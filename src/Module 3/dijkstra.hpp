@@ -0,0 +1,468 @@
+#ifndef DIJKSTRA_HPP_
+#define DIJKSTRA_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits> // For using maximum/minimum values
+#include <map>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include "indexed_heap.hpp"
+#include "tracing.hpp"
+
+/**
+ * @brief Distance of an unreached node for a given weight type: its largest value.
+ */
+template <typename Weight>
+constexpr Weight INFINITY_OF = std::numeric_limits<Weight>::max();
+
+/**
+ * @brief Constant value representing infinity.
+ */
+constexpr float INFINITY_VALUE = INFINITY_OF<float>;
+
+/**
+ * @brief Class representing a point (node) in a graph.
+ *
+ * A Point holds a node identifier and the current accumulated distance (cost) to get there.
+ *
+ * @tparam Weight Type of the distances: float (the Point alias), double, or an integer type such as
+ *                std::uint32_t or std::uint64_t for exact integer costs.
+ */
+template <typename Weight = float>
+class BasicPoint
+{
+public:
+    char node;       ///< Identifier of the node.
+    Weight distance; ///< Distance from the starting node.
+
+    /**
+     * @brief Default constructor.
+     *
+     * Creates a Point with a blank node (' ') and zero distance.
+     */
+    BasicPoint() : node(' '), distance(0) {}
+
+    /**
+     * @brief Parameterized constructor.
+     *
+     * @param n The identifier of the node.
+     * @param d The distance (cost) associated with this node.
+     */
+    BasicPoint(char n, Weight d) : node(n), distance(d) {}
+
+    /**
+     * @brief Overloads the addition operator.
+     *
+     * Although not essential for Dijkstra, this operator lets you add the distances of two points.
+     * @param other Another Point object.
+     * @return A new Point with the same node and the sum of the distances.
+     */
+    BasicPoint operator+(const BasicPoint &other) const
+    {
+        return BasicPoint(node, distance + other.distance);
+    }
+
+    /**
+     * @brief Overloaded input operator.
+     *
+     * Allows formatted input for a Point.
+     * @param is Input stream.
+     * @param p Point object to fill.
+     * @return Reference to the input stream.
+     */
+    friend std::istream &operator>>(std::istream &is, BasicPoint &p)
+    {
+        std::cout << "Enter the node (character): ";
+        is >> p.node;
+        std::cout << (std::is_integral<Weight>::value ? "Enter the distance (whole number): "
+                                                      : "Enter the distance (floating point number): ");
+        is >> p.distance;
+        return is;
+    }
+
+    /**
+     * @brief Overloaded output operator.
+     *
+     * Allows formatted output of a Point.
+     * @param os Output stream.
+     * @param p Point object to print.
+     * @return Reference to the output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const BasicPoint &p)
+    {
+        os << "Node: " << p.node << ", Distance: " << p.distance;
+        return os;
+    }
+};
+
+using Point = BasicPoint<float>; ///< The original float-weighted point.
+
+/**
+ * @brief Frontier tag selecting the original linear scan over every node (the reference mode).
+ *
+ * Each iteration walks the whole distance map looking for the cheapest unvisited node, so a full run costs
+ * O(V² log V). It is kept to diff and benchmark the heap frontiers against.
+ */
+struct LinearScan
+{
+};
+
+/**
+ * @brief Class implementing Dijkstra's algorithm for finding the shortest path.
+ *
+ * This class calculates the optimal path between a starting node and a destination node in a graph.
+ * A tracing policy decides what is reported during each algorithm step (see tracing.hpp): ConsoleTrace
+ * prints the detailed messages of the former debug mode, NoTrace (the default) compiles to nothing.
+ *
+ * The frontier (how the next node to visit is chosen) is picked at compile time:
+ * - LinearScan: the reference scan over every node, O(V) per iteration.
+ * - BinaryHeap / QuaternaryHeap: addressable heaps with decrease-key, O(log V) per operation.
+ * - LazyHeap: binary heap that re-pushes improved nodes and skips outdated copies when popping.
+ * - BucketQueue: Dial's buckets, O(1) per operation, for small integer weights (picked by SmallWeight, and
+ *   by AutoFrontier for 8- and 16-bit weights).
+ *
+ * The heaps break ties by node identifier, so those modes visit nodes in the same order as the reference
+ * scan and return the same path; the bucket queue returns the same distances but may pick another of
+ * several equally short paths.
+ *
+ * Distances use the Weight type throughout (graph, frontier keys, results). Integer weights are exact on
+ * long routes, and the heap aliases are rebound to Weight keys (see FrontierFor).
+ *
+ * @tparam Frontier LinearScan, AutoFrontier, SmallWeight, or one of the queues from indexed_heap.hpp.
+ * @tparam Trace NoTrace, CountingTrace, EventLogTrace or ConsoleTrace.
+ * @tparam Weight float (default), double, std::uint32_t, std::uint64_t...
+ */
+template <typename Frontier = LinearScan, typename Trace = NoTrace, typename Weight = float>
+class Dijkstra
+{
+public:
+    using PointType = BasicPoint<Weight>;                            ///< Node and distance.
+    using GraphType = std::map<char, std::vector<PointType>>;        ///< Adjacency map.
+    static constexpr Weight INFINITE_DISTANCE = INFINITY_OF<Weight>; ///< Distance of unreached nodes.
+
+private:
+    using Queue = FrontierFor<Frontier, Weight>;
+    static constexpr bool IS_REFERENCE = std::is_same<Frontier, LinearScan>::value;
+
+    static constexpr std::size_t NODE_IDS = std::numeric_limits<unsigned char>::max() + 1;
+    static constexpr std::int16_t NO_PREDECESSOR = -1;
+
+    std::map<char, PointType> distances;             ///< Map holding the accumulated cost for each node.
+    std::set<char> visited;                          ///< Set of nodes that have already been processed.
+    std::array<std::int16_t, NODE_IDS> predecessors; ///< Previous node (idOf) on the optimal path, or -1.
+    Queue frontier;                                  ///< Queue of reached, unvisited nodes (unused by LinearScan).
+    Trace trace;                                     ///< Receives the steps of the algorithm.
+
+    /**
+     * @brief Dense heap identifier of a node: its character code.
+     */
+    static std::uint32_t idOf(char node)
+    {
+        return static_cast<unsigned char>(node);
+    }
+
+public:
+    PointType startNode; ///< The starting point.
+    PointType endNode;   ///< The destination point.
+    GraphType graph;     ///< Graph: each node maps to a vector of connections (neighbor and cost).
+
+    /**
+     * @brief Constructor for the Dijkstra algorithm class.
+     *
+     * Initializes the algorithm with the start node, destination node and the graph.
+     *
+     * @param start The starting node.
+     * @param end The destination node.
+     * @param g The graph represented as a map.
+     */
+    Dijkstra(const PointType &start, const PointType &end, const GraphType &g)
+        : startNode(start), endNode(end), graph(g)
+    {
+        predecessors.fill(NO_PREDECESSOR);
+    }
+
+    /**
+     * @brief The tracing policy instance, to read its counters or events after a run.
+     */
+    Trace &tracer() { return trace; }
+    const Trace &tracer() const { return trace; }
+
+    /**
+     * @brief Prints the graph.
+     *
+     * Displays every node and its connections (like looking at a simple map of neighbors).
+     */
+    void printGraph() const
+    {
+        for (const auto &node : graph)
+        {
+            std::cout << "Node: " << node.first << " Connections:" << std::endl;
+            for (const auto &connection : node.second)
+            {
+                std::cout << "  [" << connection.node << ", " << connection.distance << "]" << std::endl;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * @brief Displays the visited nodes.
+     *
+     * Prints all nodes that have already been processed.
+     */
+    void displayVisited() const
+    {
+        std::cout << "Visited nodes: ";
+        for (const char &node : visited)
+        {
+            std::cout << node << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief Initializes the distances for each node.
+     *
+     * Sets the starting node's distance to 0 and every other node's distance to infinity.
+     * Think of this as knowing your home's distance (0) while all other locations are unknown (infinity).
+     * Heap frontiers are seeded with the starting node.
+     */
+    void initializeDistances()
+    {
+        for (const auto &node : graph)
+        {
+            char key = node.first;
+            distances[key] = (key == startNode.node) ? PointType(key, 0) : PointType(key, INFINITE_DISTANCE);
+        }
+        if constexpr (!IS_REFERENCE)
+        {
+            frontier.clear();
+            frontier.reserve(std::numeric_limits<unsigned char>::max() + 1);
+            if (distances.count(startNode.node) != 0)
+            {
+                frontier.push(idOf(startNode.node), Weight(0));
+            }
+        }
+    }
+
+    /**
+     * @brief Displays the current accumulated cost to each node.
+     *
+     * Shows the cost (distance) accumulated so far to reach every node.
+     *
+     * @param out Stream to write to (not flushed).
+     */
+    void displayDistances(std::ostream &out = std::cout) const
+    {
+        for (const auto &pair : distances)
+        {
+            out << "Node: " << pair.first << ", Distance: " << pair.second.distance << '\n';
+        }
+    }
+
+    /**
+     * @brief Retrieves the unvisited node with the minimum provisional distance.
+     *
+     * Iterates over all nodes and selects the one that is unvisited and has the smallest known cost.
+     * Think of it as finding the shortest unexplored road.
+     *
+     * @return The node identifier with the smallest accumulated cost, or ' ' if none is found.
+     */
+    char getMinimumNode()
+    {
+        Weight minValue = INFINITE_DISTANCE;
+        char minNode = ' ';
+        for (const auto &pair : distances)
+        {
+            if (visited.find(pair.first) == visited.end() && pair.second.distance < minValue)
+            {
+                minValue = pair.second.distance;
+                minNode = pair.first;
+            }
+        }
+        return minNode;
+    }
+
+    /**
+     * @brief Retrieves the next node to visit from the selected frontier.
+     *
+     * The reference mode scans with getMinimumNode(); heap modes pop the smallest entry, skipping copies
+     * of nodes that were already visited (only the lazy heap leaves those behind).
+     *
+     * @return The node identifier with the smallest accumulated cost, or ' ' if none is found.
+     */
+    char nextNode()
+    {
+        if constexpr (IS_REFERENCE)
+        {
+            char node = getMinimumNode();
+            if (node != ' ')
+            {
+                trace.pop(node, distances[node].distance);
+            }
+            return node;
+        }
+        else
+        {
+            std::uint32_t id;
+            Weight key;
+            while (frontier.pop(id, key))
+            {
+                char node = static_cast<char>(id);
+                trace.pop(node, key);
+                if (visited.find(node) == visited.end())
+                {
+                    return node;
+                }
+            }
+            return ' ';
+        }
+    }
+
+    /**
+     * @brief Updates the distances of the nodes adjacent to the current node.
+     *
+     * For each neighbor of the current node, if traveling through the current node offers a cheaper path,
+     * update the neighbor's cost and mark the current node as its predecessor.
+     *
+     * @param currentNode The node from which to update neighboring nodes.
+     */
+    void updateDistances(char currentNode)
+    {
+        // Loop through each connection (edge) from the current node.
+        for (const auto &connection : graph[currentNode])
+        {
+            if (visited.find(connection.node) == visited.end())
+            {
+                // Calculate new distance: cost so far + cost from current to neighbor.
+                Weight newDistance = distances[currentNode].distance + connection.distance;
+                trace.relax(currentNode, connection.node, newDistance);
+                // If the new found path is shorter, update the cost for the neighbor.
+                if (newDistance < distances[connection.node].distance)
+                {
+                    trace.decrease(connection.node, newDistance);
+                    distances[connection.node].distance = newDistance;
+                    // Record the predecessor.
+                    predecessors[idOf(connection.node)] = static_cast<std::int16_t>(idOf(currentNode));
+                    if constexpr (!IS_REFERENCE)
+                    {
+                        frontier.push(idOf(connection.node), newDistance);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the shortest path into a caller-owned buffer, from the start node to the destination.
+     *
+     * Walks back from the end node through the flat predecessor array twice: once to count the steps,
+     * once to fill the buffer from its end, so the nodes come out in forward order without a reversal and
+     * without allocating.
+     *
+     * @param out Buffer receiving the node identifiers.
+     * @param capacity Number of chars available in out.
+     * @return The path length, or 0 if the destination was not reached. If the length exceeds capacity
+     *         nothing is written.
+     */
+    std::size_t reconstructPathInto(char *out, std::size_t capacity) const
+    {
+        std::size_t length = 1;
+        // Trace steps back until the starting node is reached.
+        for (char current = endNode.node; current != startNode.node; length++)
+        {
+            // If a link is missing, then the path does not exist.
+            if (predecessors[idOf(current)] == NO_PREDECESSOR)
+            {
+                return 0;
+            }
+            current = static_cast<char>(predecessors[idOf(current)]);
+        }
+        if (length > capacity)
+        {
+            return length;
+        }
+        char current = endNode.node;
+        for (std::size_t slot = length; slot > 0; --slot)
+        {
+            out[slot - 1] = current;
+            current = static_cast<char>(predecessors[idOf(current)]);
+        }
+        return length;
+    }
+
+    /**
+     * @brief Reconstructs the shortest path from the source to the destination.
+     *
+     * @return A vector of node identifiers representing the shortest path (empty if there is none).
+     */
+    std::vector<char> reconstructPath() const
+    {
+        std::vector<char> path(NODE_IDS);
+        path.resize(reconstructPathInto(path.data(), path.size()));
+        return path;
+    }
+
+    /**
+     * @brief Executes Dijkstra's algorithm.
+     *
+     * The algorithm performs the following steps:
+     * 1. Find the unvisited node with the smallest distance.
+     * 2. Mark that node as visited (it will not be checked again).
+     * 3. Update (relax) the distances for each of its neighboring nodes.
+     * 4. Repeat until all nodes are visited or the destination is reached.
+     *
+     * Every step is reported to the tracing policy.
+     */
+    void calculateDistances()
+    {
+        std::uint32_t iteration = 0;
+        while (visited.size() < distances.size())
+        {
+            // Step 1: Find the unvisited node with the smallest accumulated cost.
+            char current = nextNode();
+            if (current == ' ')
+                break; // No reachable unvisited node is found.
+
+            // Mark the current node as visited.
+            visited.insert(current);
+            iteration++;
+            trace.iteration(iteration, current);
+
+            // Step 2: If the current node is the destination, then stop.
+            if (current == endNode.node)
+            {
+                trace.reachedTarget(current);
+                break;
+            }
+
+            // Step 3: Update the distances for each neighbor of the current node.
+            updateDistances(current);
+            trace.updated(*this);
+        }
+        trace.finished(iteration);
+
+        // Reconstruct and print the shortest path.
+        std::vector<char> path = reconstructPath();
+        if (!path.empty())
+        {
+            std::cout << "Shortest path:" << std::endl;
+            for (char n : path)
+            {
+                std::cout << n << " ";
+            }
+            std::cout << std::endl;
+        }
+        else
+        {
+            std::cout << "No path found to the destination." << std::endl;
+        }
+    }
+};
+
+#endif // DIJKSTRA_HPP_
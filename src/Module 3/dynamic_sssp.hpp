@@ -0,0 +1,280 @@
+#ifndef DYNAMIC_SSSP_HPP_
+#define DYNAMIC_SSSP_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+
+/**
+ * @brief Shortest-path tree from one source, kept up to date while edge weights change.
+ *
+ * The engine owns a copy of the weights, so it can change them, and builds an index of the edges
+ * entering every node. After a weight update only the part of the tree that the update can affect is
+ * recomputed:
+ *  - Decrease of u -> v: if it shortens the way to v, v is lowered and the improvement spreads with a
+ *    Dijkstra that only visits nodes whose distance actually drops.
+ *  - Increase of u -> v: nothing changes unless the edge is v's tree edge. Then only the subtree below v
+ *    can get longer: it is cut off, each of its nodes takes the best way in from outside the subtree,
+ *    and a Dijkstra restricted to the subtree settles it again.
+ * Both cost about the number of affected nodes times their degree, not the graph size. Distances are
+ * the same as a fresh CsrDijkstra run on the updated weights.
+ *
+ * Edges are identified by their CSR slot (the index into targets/weights).
+ */
+class DynamicShortestPaths
+{
+public:
+    /**
+     * @brief Copies the weights of g, indexes its incoming edges and computes the tree from source.
+     *
+     * The graph structure (offsets, targets) must outlive the engine; only the weights are copied.
+     */
+    DynamicShortestPaths(CsrView g, std::uint32_t source)
+        : graph(g), weights(g.weights, g.weights + g.edgeCount), tails(g.edgeCount), inOffsets(g.nodeCount + 1, 0),
+          inEdges(g.edgeCount), distances(g.nodeCount, INFINITY_VALUE), treeEdges(g.nodeCount, NO_NODE),
+          affected(g.nodeCount, 0), frontier(g.nodeCount), startNode(source)
+    {
+        graph.weights = weights.data();
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+            {
+                tails[edge] = node;
+                inOffsets[g.targets[edge] + 1]++;
+            }
+        }
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            inOffsets[node + 1] += inOffsets[node];
+        }
+        std::vector<std::uint32_t> cursor(inOffsets.begin(), inOffsets.end() - 1);
+        for (std::uint32_t edge = 0; edge < g.edgeCount; ++edge)
+        {
+            inEdges[cursor[g.targets[edge]]++] = edge;
+        }
+
+        distances[source] = 0.0f;
+        frontier.push(source, 0.0f);
+        propagate(false);
+    }
+
+    /**
+     * @brief Graph with the current weights (valid while the engine is alive).
+     */
+    CsrView view() const { return graph; }
+
+    std::uint32_t source() const { return startNode; }
+
+    /**
+     * @brief Number of weight updates applied so far (a graph version for caches).
+     */
+    std::uint64_t version() const { return updates; }
+
+    /**
+     * @brief Current shortest distance to node, or INFINITY_VALUE if it cannot be reached.
+     */
+    float distance(std::uint32_t node) const { return distances[node]; }
+
+    /**
+     * @brief Previous node on the current shortest path to node, or NO_NODE.
+     */
+    std::uint32_t predecessor(std::uint32_t node) const
+    {
+        return treeEdges[node] == NO_NODE ? NO_NODE : tails[treeEdges[node]];
+    }
+
+    /**
+     * @brief Current weight of an edge.
+     */
+    float weight(std::uint32_t edge) const { return weights[edge]; }
+
+    /**
+     * @brief Nodes whose tree entry was recomputed by the last update.
+     */
+    std::uint32_t repairedCount() const { return repaired; }
+
+    /**
+     * @brief Current shortest path from the source to target, or an empty vector if there is none.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t target) const
+    {
+        std::vector<std::uint32_t> result;
+        if (distances[target] == INFINITY_VALUE)
+        {
+            return result;
+        }
+        for (std::uint32_t node = target; node != NO_NODE; node = predecessor(node))
+        {
+            result.push_back(node);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Sets the weight of the first edge from -> to and repairs the tree.
+     *
+     * @return false if there is no such edge.
+     */
+    bool updateWeight(std::uint32_t from, std::uint32_t to, float newWeight)
+    {
+        for (std::uint32_t edge = graph.firstEdge(from); edge < graph.lastEdge(from); ++edge)
+        {
+            if (graph.targets[edge] == to)
+            {
+                updateEdge(edge, newWeight);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Sets the weight of an edge (by CSR slot) and repairs the tree. The weight must be non-negative.
+     */
+    void updateEdge(std::uint32_t edge, float newWeight)
+    {
+        float oldWeight = weights[edge];
+        weights[edge] = newWeight;
+        updates++;
+        repaired = 0;
+        if (newWeight < oldWeight)
+        {
+            decrease(edge);
+        }
+        else if (oldWeight < newWeight && treeEdges[graph.targets[edge]] == edge)
+        {
+            increase(graph.targets[edge]);
+        }
+    }
+
+private:
+    CsrView graph;                          ///< Structure of the graph, pointing at the owned weights.
+    std::vector<float> weights;             ///< Current edge weights.
+    std::vector<std::uint32_t> tails;       ///< Tail node of every edge.
+    std::vector<std::uint32_t> inOffsets;   ///< nodeCount + 1 offsets into inEdges.
+    std::vector<std::uint32_t> inEdges;     ///< Edges entering each node, grouped by head node.
+    std::vector<float> distances;           ///< Current distance of every node.
+    std::vector<std::uint32_t> treeEdges;   ///< Edge through which every node is reached, or NO_NODE.
+    std::vector<std::uint8_t> affected;     ///< Marks the subtree being rebuilt after an increase.
+    std::vector<std::uint32_t> subtree;     ///< Nodes of that subtree.
+    BinaryHeap frontier;                    ///< Nodes whose distance changed and must be spread.
+    std::uint32_t startNode;                ///< Root of the tree.
+    std::uint32_t repaired = 0;             ///< Nodes recomputed by the last update.
+    std::uint64_t updates = 0;              ///< Weight updates applied.
+
+    /**
+     * @brief A cheaper edge u -> v can only help v and what lies behind it.
+     */
+    void decrease(std::uint32_t edge)
+    {
+        std::uint32_t from = tails[edge];
+        std::uint32_t to = graph.targets[edge];
+        if (distances[from] == INFINITY_VALUE)
+        {
+            return;
+        }
+        float candidate = distances[from] + weights[edge];
+        if (candidate < distances[to])
+        {
+            distances[to] = candidate;
+            treeEdges[to] = edge;
+            frontier.push(to, candidate);
+            propagate(false);
+        }
+    }
+
+    /**
+     * @brief The tree edge of node got more expensive: rebuild the subtree hanging below it.
+     */
+    void increase(std::uint32_t node)
+    {
+        // Collect the subtree: children are the heads of edges that are their own tree edge.
+        subtree.clear();
+        subtree.push_back(node);
+        affected[node] = 1;
+        for (std::size_t i = 0; i < subtree.size(); ++i)
+        {
+            std::uint32_t parent = subtree[i];
+            for (std::uint32_t edge = graph.firstEdge(parent); edge < graph.lastEdge(parent); ++edge)
+            {
+                std::uint32_t child = graph.targets[edge];
+                if (treeEdges[child] == edge && !affected[child])
+                {
+                    affected[child] = 1;
+                    subtree.push_back(child);
+                }
+            }
+        }
+
+        // Every subtree node starts from its best way in from outside the subtree.
+        for (std::uint32_t member : subtree)
+        {
+            float best = INFINITY_VALUE;
+            std::uint32_t bestEdge = NO_NODE;
+            for (std::uint32_t i = inOffsets[member]; i < inOffsets[member + 1]; ++i)
+            {
+                std::uint32_t edge = inEdges[i];
+                std::uint32_t from = tails[edge];
+                if (affected[from] || distances[from] == INFINITY_VALUE)
+                {
+                    continue;
+                }
+                float candidate = distances[from] + weights[edge];
+                if (candidate < best)
+                {
+                    best = candidate;
+                    bestEdge = edge;
+                }
+            }
+            distances[member] = best;
+            treeEdges[member] = bestEdge;
+            if (bestEdge != NO_NODE)
+            {
+                frontier.push(member, best);
+            }
+        }
+
+        // Distances outside the subtree did not change, so the search stays inside it.
+        propagate(true);
+        for (std::uint32_t member : subtree)
+        {
+            affected[member] = 0;
+        }
+    }
+
+    /**
+     * @brief Dijkstra from the queued nodes, lowering every node it can improve.
+     *
+     * @param insideSubtree Only relax edges into the affected subtree.
+     */
+    void propagate(bool insideSubtree)
+    {
+        std::uint32_t current;
+        float key;
+        while (frontier.pop(current, key))
+        {
+            repaired++;
+            for (std::uint32_t edge = graph.firstEdge(current); edge < graph.lastEdge(current); ++edge)
+            {
+                std::uint32_t next = graph.targets[edge];
+                if (insideSubtree && !affected[next])
+                {
+                    continue;
+                }
+                float candidate = key + weights[edge];
+                if (candidate < distances[next])
+                {
+                    distances[next] = candidate;
+                    treeEdges[next] = edge;
+                    frontier.push(next, candidate);
+                }
+            }
+        }
+    }
+};
+
+#endif // DYNAMIC_SSSP_HPP_
@@ -0,0 +1,279 @@
+#ifndef EDGE_LIST_PARSER_HPP_
+#define EDGE_LIST_PARSER_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief Settings of the edge-list reader.
+ */
+struct EdgeListOptions
+{
+    unsigned threads = 1;                  ///< Threads parsing each chunk (0 = one per hardware thread).
+    std::size_t chunkSize = 16u << 20;     ///< Bytes read from the file at a time.
+    char separator = ',';                  ///< Field separator between from, to and weight.
+    std::uint32_t maxNodeCount = 1u << 27; ///< loadEdgeList() rejects node ids at or above this.
+};
+
+/**
+ * @brief Parses whole lines of "from,to,weight" text.
+ *
+ * Numbers go through std::from_chars: no locale, no stream state, no allocation. Spaces and tabs around
+ * fields, '\r' line ends, blank lines and lines starting with '#' are accepted. With a space or tab
+ * separator, any run of spaces and tabs separates two fields.
+ */
+class EdgeListChunkParser
+{
+public:
+    EdgeListChunkParser(char fieldSeparator, std::vector<Edge> &output)
+        : separator(fieldSeparator), edges(output)
+    {
+    }
+
+    /**
+     * @brief Parses [begin, end), which must end at a line boundary (or at the end of the input).
+     *
+     * @return true on success; on a malformed line, false with errorAt() pointing into it.
+     */
+    bool parse(const char *begin, const char *end)
+    {
+        const char *cursor = begin;
+        while (cursor < end)
+        {
+            const char *lineEnd =
+                static_cast<const char *>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+            lines++;
+            if (!parseLine(cursor, lineEnd))
+            {
+                error = cursor;
+                return false;
+            }
+            cursor = lineEnd + 1;
+        }
+        return true;
+    }
+
+    const char *errorAt() const { return error; }
+
+    /**
+     * @brief Lines read so far, including the malformed one.
+     */
+    std::size_t lineCount() const { return lines; }
+
+private:
+    char separator;
+    std::vector<Edge> &edges;
+    const char *error = nullptr;
+    std::size_t lines = 0;
+
+    static const char *skipBlanks(const char *cursor, const char *end)
+    {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    template <typename Number>
+    bool field(const char *&cursor, const char *end, Number &value, bool last)
+    {
+        cursor = skipBlanks(cursor, end);
+        std::from_chars_result result = std::from_chars(cursor, end, value);
+        if (result.ec != std::errc())
+        {
+            return false;
+        }
+        cursor = skipBlanks(result.ptr, end);
+        if (last)
+        {
+            return cursor == end;
+        }
+        if (cursor == end)
+        {
+            return false;
+        }
+        if (*cursor == separator)
+        {
+            ++cursor;
+            return true;
+        }
+        // A space or tab separator was skipped along with the padding.
+        return (separator == ' ' || separator == '\t') && cursor > result.ptr;
+    }
+
+    bool parseLine(const char *cursor, const char *end)
+    {
+        const char *first = skipBlanks(cursor, end);
+        if (first == end || *first == '#')
+        {
+            return true;
+        }
+        Edge edge;
+        if (!field(cursor, end, edge.from, false) || !field(cursor, end, edge.to, false) ||
+            !field(cursor, end, edge.weight, true))
+        {
+            return false;
+        }
+        if (!(edge.weight >= 0.0f) || edge.from == NO_NODE || edge.to == NO_NODE)
+        {
+            return false; // Negative or NaN weight, or an id that collides with NO_NODE.
+        }
+        edges.push_back(edge);
+        return true;
+    }
+};
+
+/**
+ * @brief Reads a "from,to,weight" edge list from a stream in large chunks.
+ *
+ * Data is read with fread() into a chunkSize buffer; the incomplete last line of a chunk is carried
+ * over to the next one. With several threads each chunk is cut at line boundaries into pieces parsed in
+ * parallel (by threads started once for the whole file), and the pieces are appended in order, so the
+ * edges keep the file order whatever the thread count.
+ *
+ * @throws std::runtime_error with the line number on a malformed line, or on a read error.
+ */
+inline std::vector<Edge> readEdgeList(std::FILE *input, const EdgeListOptions &options = EdgeListOptions())
+{
+    ThreadPool pool(options.threads);
+    const std::size_t pieceCount = pool.threadCount() == 1 ? 1 : std::size_t(pool.threadCount()) * 4;
+    std::vector<Edge> edges;
+    std::vector<std::vector<Edge>> pieceEdges(pieceCount);
+    std::vector<const char *> bounds(pieceCount + 1);
+    std::vector<std::size_t> pieceLines(pieceCount);
+    std::vector<const char *> pieceErrors(pieceCount);
+    std::vector<char> buffer(std::max<std::size_t>(options.chunkSize, 1));
+    std::size_t filled = 0;
+    std::size_t linesBefore = 0;
+    bool atEnd = false;
+
+    while (!atEnd)
+    {
+        if (filled == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2); // A single line longer than the chunk.
+        }
+        filled += std::fread(buffer.data() + filled, 1, buffer.size() - filled, input);
+        atEnd = filled < buffer.size();
+        if (atEnd && std::ferror(input))
+        {
+            throw std::runtime_error("error while reading the edge list");
+        }
+        const char *begin = buffer.data();
+        const char *end = begin + filled;
+        if (!atEnd)
+        {
+            const char *lastNewline = begin + filled;
+            while (lastNewline > begin && lastNewline[-1] != '\n')
+            {
+                --lastNewline;
+            }
+            if (lastNewline == begin)
+            {
+                continue; // No complete line yet: read more.
+            }
+            end = lastNewline;
+        }
+
+        // Cut [begin, end) into pieces that start right after a newline.
+        bounds[0] = begin;
+        for (std::size_t i = 1; i < pieceCount; ++i)
+        {
+            const char *cut =
+                std::max(bounds[i - 1], begin + static_cast<std::size_t>(end - begin) * i / pieceCount);
+            while (cut < end && cut > begin && cut[-1] != '\n')
+            {
+                ++cut;
+            }
+            bounds[i] = cut;
+        }
+        bounds[pieceCount] = end;
+        pool.parallelFor(pieceCount, 1,
+                         [&](unsigned, std::size_t first, std::size_t last)
+                         {
+                             for (std::size_t i = first; i < last; ++i)
+                             {
+                                 pieceEdges[i].clear();
+                                 EdgeListChunkParser parser(options.separator, pieceEdges[i]);
+                                 parser.parse(bounds[i], bounds[i + 1]);
+                                 pieceLines[i] = parser.lineCount();
+                                 pieceErrors[i] = parser.errorAt();
+                             }
+                         });
+        for (std::size_t i = 0; i < pieceCount; ++i)
+        {
+            if (pieceErrors[i] != nullptr)
+            {
+                throw std::runtime_error("malformed edge list line " + std::to_string(linesBefore + pieceLines[i]));
+            }
+            linesBefore += pieceLines[i];
+            edges.insert(edges.end(), pieceEdges[i].begin(), pieceEdges[i].end());
+        }
+
+        // Keep the incomplete last line for the next read.
+        std::size_t rest = static_cast<std::size_t>(begin + filled - end);
+        std::memmove(buffer.data(), end, rest);
+        filled = rest;
+    }
+    return edges;
+}
+
+/**
+ * @brief Loads a "from,to,weight" edge-list file into a CSR graph (node ids are the numbers in the file).
+ *
+ * The graph gets one node per id up to the largest one in the file, so a single stray id near 2^32 would
+ * allocate gigabytes of empty rows. Ids at or above options.maxNodeCount are refused instead; raise the
+ * limit for graphs that really are that large.
+ *
+ * @throws std::runtime_error if the file cannot be opened, is malformed or has an id beyond the limit.
+ */
+inline CsrGraph loadEdgeList(const std::string &path, const EdgeListOptions &options = EdgeListOptions())
+{
+    std::FILE *input = std::fopen(path.c_str(), "rb");
+    if (input == nullptr)
+    {
+        throw std::runtime_error("cannot open edge list " + path);
+    }
+    std::vector<Edge> edges;
+    try
+    {
+        edges = readEdgeList(input, options);
+    }
+    catch (...)
+    {
+        std::fclose(input);
+        throw;
+    }
+    std::fclose(input);
+
+    std::uint32_t nodeCount = 0;
+    for (const Edge &edge : edges)
+    {
+        std::uint32_t largest = std::max(edge.from, edge.to);
+        if (largest >= options.maxNodeCount)
+        {
+            throw std::runtime_error("node id " + std::to_string(largest) + " in " + path +
+                                     " is beyond the limit of " + std::to_string(options.maxNodeCount) +
+                                     " nodes (EdgeListOptions::maxNodeCount)");
+        }
+        nodeCount = std::max(nodeCount, largest + 1);
+    }
+    return buildCsrGraph(nodeCount, edges);
+}
+
+#endif // EDGE_LIST_PARSER_HPP_
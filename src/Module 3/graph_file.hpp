@@ -0,0 +1,350 @@
+#ifndef GRAPH_FILE_HPP_
+#define GRAPH_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief Fixed-size header at the start of a binary graph file.
+ *
+ * The file is the header followed by the CSR arrays, each starting on a 64-byte boundary, stored in the
+ * machine's native (little-endian) layout so they can be used in place:
+ *
+ *     header | offsets (nodeCount + 1 x u32) | targets (edgeCount x u32) | weights (edgeCount x f32)
+ *            | coordinates (nodeCount x 2 f64, optional) | labels (nodeCount chars, optional)
+ *
+ * A section that is absent has position 0. The checksum covers every byte after the header.
+ */
+struct GraphFileHeader
+{
+    char magic[8];                ///< "CSRGRAPH".
+    std::uint32_t version;        ///< GRAPH_FILE_VERSION.
+    std::uint32_t reserved;       ///< Zero.
+    std::uint32_t nodeCount;      ///< Number of nodes.
+    std::uint32_t edgeCount;      ///< Number of edges.
+    std::uint64_t offsetsAt;      ///< Byte position of the offsets array.
+    std::uint64_t targetsAt;      ///< Byte position of the targets array.
+    std::uint64_t weightsAt;      ///< Byte position of the weights array.
+    std::uint64_t coordinatesAt;  ///< Byte position of the coordinates array, or 0.
+    std::uint64_t labelsAt;       ///< Byte position of the labels array, or 0.
+    std::uint64_t fileSize;       ///< Total size of the file in bytes.
+    std::uint64_t checksum;       ///< graphFileChecksum() of the bytes after the header.
+};
+
+constexpr std::uint32_t GRAPH_FILE_VERSION = 1;
+constexpr char GRAPH_FILE_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+
+/**
+ * @brief Running FNV-1a style hash over 64-bit words (the payload is padded to whole words).
+ */
+inline std::uint64_t graphFileChecksum(const unsigned char *data, std::size_t size,
+                                       std::uint64_t hash = 0xcbf29ce484222325ull)
+{
+    for (std::size_t i = 0; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes a graph to a binary graph file (see GraphFileHeader).
+ *
+ * @param path File to create or overwrite.
+ * @param g Graph to store; its coordinates are stored when present.
+ * @param labels nodeCount character names to store, or nullptr.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+inline void writeGraphFile(const std::string &path, CsrView g, const char *labels = nullptr)
+{
+    auto align = [](std::uint64_t position) { return (position + 63) / 64 * 64; };
+
+    GraphFileHeader header = {};
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.nodeCount = g.nodeCount;
+    header.edgeCount = g.edgeCount;
+    header.offsetsAt = align(sizeof(GraphFileHeader));
+    header.targetsAt = align(header.offsetsAt + (std::uint64_t(g.nodeCount) + 1) * sizeof(std::uint32_t));
+    header.weightsAt = align(header.targetsAt + std::uint64_t(g.edgeCount) * sizeof(std::uint32_t));
+    std::uint64_t end = header.weightsAt + std::uint64_t(g.edgeCount) * sizeof(float);
+    if (g.coordinates != nullptr)
+    {
+        header.coordinatesAt = align(end);
+        end = header.coordinatesAt + std::uint64_t(g.nodeCount) * sizeof(Coordinate);
+    }
+    if (labels != nullptr)
+    {
+        header.labelsAt = align(end);
+        end = header.labelsAt + g.nodeCount;
+    }
+    header.fileSize = (end + 7) / 8 * 8;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("cannot create graph file " + path);
+    }
+    // The header is written last, once the checksum of the payload is known.
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::uint64_t position = sizeof(header);
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    unsigned char pending[8];
+    std::size_t pendingSize = 0;
+    auto put = [&](const void *data, std::uint64_t size)
+    {
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        // Feed the checksum 8 bytes at a time across section boundaries.
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        while (size > 0)
+        {
+            if (pendingSize == 0 && size >= 8)
+            {
+                std::size_t whole = size / 8 * 8;
+                hash = graphFileChecksum(bytes, whole, hash);
+                bytes += whole;
+                size -= whole;
+                continue;
+            }
+            pending[pendingSize++] = *bytes++;
+            size--;
+            if (pendingSize == 8)
+            {
+                hash = graphFileChecksum(pending, 8, hash);
+                pendingSize = 0;
+            }
+        }
+    };
+    auto section = [&](std::uint64_t at, const void *data, std::uint64_t size)
+    {
+        static const char zeros[64] = {};
+        put(zeros, at - position);
+        put(data, size);
+        position = at + size;
+    };
+    static const std::uint32_t emptyOffsets[1] = {0}; // An empty CsrGraph has no offsets array at all.
+    section(header.offsetsAt, g.offsets != nullptr ? g.offsets : emptyOffsets,
+            (std::uint64_t(g.nodeCount) + 1) * sizeof(std::uint32_t));
+    section(header.targetsAt, g.targets, std::uint64_t(g.edgeCount) * sizeof(std::uint32_t));
+    section(header.weightsAt, g.weights, std::uint64_t(g.edgeCount) * sizeof(float));
+    if (g.coordinates != nullptr)
+    {
+        section(header.coordinatesAt, g.coordinates, std::uint64_t(g.nodeCount) * sizeof(Coordinate));
+    }
+    if (labels != nullptr)
+    {
+        section(header.labelsAt, labels, g.nodeCount);
+    }
+    section(header.fileSize, nullptr, 0);
+    header.checksum = hash;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!out.flush())
+    {
+        throw std::runtime_error("cannot write graph file " + path);
+    }
+}
+
+/**
+ * @brief Writes an in-memory graph, with its labels and coordinates, to a binary graph file.
+ *
+ * A map<char, vector<Point>> literal goes through buildCsrGraph() first.
+ */
+inline void writeGraphFile(const std::string &path, const CsrGraph &g)
+{
+    writeGraphFile(path, g.view(), g.labels.empty() ? nullptr : g.labels.data());
+}
+
+/**
+ * @brief Binary graph file mapped into memory and used in place.
+ *
+ * Opening only maps the file and checks the header, so it costs the same for a kilobyte or for many
+ * gigabytes; pages are read from disk (or the page cache) the first time a query touches them, and
+ * several processes mapping the same file share one copy in memory. view() points straight into the
+ * mapping: nothing is parsed or copied. The checksum is not verified on open, since that would read the
+ * whole file; call verifyChecksum() when the file may be damaged, or validate() before serving a file of
+ * unknown origin to the engines, which index the arrays without bounds checks.
+ */
+class MappedGraph
+{
+public:
+    /**
+     * @brief Maps a graph file.
+     *
+     * @throws std::runtime_error if the file cannot be opened or is not a valid graph file.
+     */
+    explicit MappedGraph(const std::string &path)
+    {
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            throw std::runtime_error("cannot open graph file " + path);
+        }
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < sizeof(GraphFileHeader))
+        {
+            ::close(descriptor);
+            throw std::runtime_error("graph file too small: " + path);
+        }
+        size = static_cast<std::size_t>(status.st_size);
+        void *address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+        ::close(descriptor); // The mapping keeps the file alive.
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("cannot map graph file " + path);
+        }
+        base = static_cast<const unsigned char *>(address);
+        if (!headerIsValid())
+        {
+            ::munmap(const_cast<unsigned char *>(base), size);
+            throw std::runtime_error("not a valid graph file: " + path);
+        }
+    }
+
+    MappedGraph(const MappedGraph &) = delete;
+    MappedGraph &operator=(const MappedGraph &) = delete;
+
+    MappedGraph(MappedGraph &&other) noexcept : base(other.base), size(other.size)
+    {
+        other.base = nullptr;
+        other.size = 0;
+    }
+
+    MappedGraph &operator=(MappedGraph &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            base = other.base;
+            size = other.size;
+            other.base = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    ~MappedGraph() { unmap(); }
+
+    const GraphFileHeader &header() const { return *reinterpret_cast<const GraphFileHeader *>(base); }
+
+    std::uint32_t nodeCount() const { return header().nodeCount; }
+    std::uint32_t edgeCount() const { return header().edgeCount; }
+
+    /**
+     * @brief View over the mapped arrays. Valid while this object is alive.
+     */
+    CsrView view() const
+    {
+        const GraphFileHeader &h = header();
+        CsrView v;
+        v.nodeCount = h.nodeCount;
+        v.edgeCount = h.edgeCount;
+        v.offsets = reinterpret_cast<const std::uint32_t *>(base + h.offsetsAt);
+        v.targets = reinterpret_cast<const std::uint32_t *>(base + h.targetsAt);
+        v.weights = reinterpret_cast<const float *>(base + h.weightsAt);
+        v.coordinates = h.coordinatesAt == 0 ? nullptr : reinterpret_cast<const Coordinate *>(base + h.coordinatesAt);
+        return v;
+    }
+
+    /**
+     * @brief Character name of every node, or nullptr if the file has none.
+     */
+    const char *labels() const
+    {
+        return header().labelsAt == 0 ? nullptr : reinterpret_cast<const char *>(base + header().labelsAt);
+    }
+
+    /**
+     * @brief Reads the whole file and compares its checksum with the header.
+     */
+    bool verifyChecksum() const
+    {
+        return graphFileChecksum(base + sizeof(GraphFileHeader), size - sizeof(GraphFileHeader)) ==
+               header().checksum;
+    }
+
+    /**
+     * @brief Reads the CSR arrays and checks that the engines can walk them safely.
+     *
+     * Offsets must never decrease (the header check already pinned the first and last one), every target
+     * must be a node of the graph and every weight a non-negative number. A file that passes can be
+     * searched without reading out of bounds, whatever its checksum says; a file that fails may be
+     * damaged or was not written by writeGraphFile().
+     */
+    bool validate() const
+    {
+        CsrView g = view();
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            if (g.offsets[node] > g.offsets[node + 1])
+            {
+                return false;
+            }
+        }
+        for (std::uint32_t edge = 0; edge < g.edgeCount; ++edge)
+        {
+            if (g.targets[edge] >= g.nodeCount || !(g.weights[edge] >= 0.0f))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const unsigned char *base = nullptr; ///< Start of the mapping.
+    std::size_t size = 0;                ///< Length of the mapping.
+
+    void unmap()
+    {
+        if (base != nullptr)
+        {
+            ::munmap(const_cast<unsigned char *>(base), size);
+            base = nullptr;
+        }
+    }
+
+    /**
+     * @brief Checks magic, version, that every section lies inside the file and that the offsets start at 0
+     *        and end at edgeCount; reads two pages at most.
+     */
+    bool headerIsValid() const
+    {
+        const GraphFileHeader &h = header();
+        if (std::memcmp(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic)) != 0 || h.version != GRAPH_FILE_VERSION ||
+            h.fileSize != size)
+        {
+            return false;
+        }
+        auto fits = [&](std::uint64_t at, std::uint64_t bytes, std::uint64_t alignment)
+        { return at >= sizeof(GraphFileHeader) && at % alignment == 0 && at <= size && bytes <= size - at; };
+        std::uint64_t nodes = h.nodeCount;
+        std::uint64_t edges = h.edgeCount;
+        if (!fits(h.offsetsAt, (nodes + 1) * 4, 4) || !fits(h.targetsAt, edges * 4, 4) ||
+            !fits(h.weightsAt, edges * 4, 4) ||
+            (h.coordinatesAt != 0 && !fits(h.coordinatesAt, nodes * sizeof(Coordinate), alignof(Coordinate))) ||
+            (h.labelsAt != 0 && !fits(h.labelsAt, nodes, 1)))
+        {
+            return false;
+        }
+        const std::uint32_t *offsets = reinterpret_cast<const std::uint32_t *>(base + h.offsetsAt);
+        return offsets[0] == 0 && offsets[h.nodeCount] == h.edgeCount;
+    }
+};
+
+#endif // GRAPH_FILE_HPP_
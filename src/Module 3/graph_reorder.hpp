@@ -0,0 +1,402 @@
+#ifndef GRAPH_REORDER_HPP_
+#define GRAPH_REORDER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+
+/**
+ * @brief Node numbering produced by computeNodeOrder().
+ */
+enum class NodeOrder
+{
+    Bfs,                 ///< Breadth-first order: neighbors get nearby ids.
+    ReverseCuthillMcKee, ///< BFS from a peripheral node, neighbors by increasing degree, then reversed.
+    Hilbert              ///< Position along a Hilbert curve through the coordinates (geometric graphs only).
+};
+
+/**
+ * @brief Sort key of a point on a 2^16 x 2^16 Hilbert curve: nearby keys are nearby points.
+ */
+inline std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+{
+    const std::uint32_t side = 1u << 16;
+    std::uint64_t index = 0;
+    for (std::uint32_t half = side / 2; half > 0; half /= 2)
+    {
+        std::uint32_t rx = (x & half) != 0 ? 1 : 0;
+        std::uint32_t ry = (y & half) != 0 ? 1 : 0;
+        index += std::uint64_t(half) * half * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve inside it starts where the previous one ended.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Computes a cache-friendly numbering of the nodes of g.
+ *
+ * Edges are followed in both directions, so a one-way street still pulls its ends together. Nodes of
+ * different connected components get consecutive blocks, each started from its smallest old id (Bfs)
+ * or from a pseudo-peripheral node found with the George-Liu heuristic (ReverseCuthillMcKee).
+ *
+ * @param g Graph to renumber.
+ * @param order Numbering to compute.
+ * @return order[newId] = oldId, a permutation of [0, nodeCount).
+ * @throws std::invalid_argument for Hilbert on a graph without coordinates.
+ */
+inline std::vector<std::uint32_t> computeNodeOrder(CsrView g, NodeOrder order)
+{
+    std::vector<std::uint32_t> result;
+    result.reserve(g.nodeCount);
+
+    if (order == NodeOrder::Hilbert)
+    {
+        if (g.coordinates == nullptr)
+        {
+            throw std::invalid_argument("Hilbert order needs node coordinates");
+        }
+        double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
+        double minY = minX, maxY = maxX;
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            minX = std::min(minX, g.coordinates[node].x);
+            maxX = std::max(maxX, g.coordinates[node].x);
+            minY = std::min(minY, g.coordinates[node].y);
+            maxY = std::max(maxY, g.coordinates[node].y);
+        }
+        // Same scale on both axes, so the curve does not stretch a long, narrow map.
+        const double extent = std::max({maxX - minX, maxY - minY, 1e-12});
+        const double scale = 65535.0 / extent;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys(g.nodeCount);
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            auto x = static_cast<std::uint32_t>((g.coordinates[node].x - minX) * scale);
+            auto y = static_cast<std::uint32_t>((g.coordinates[node].y - minY) * scale);
+            keys[node] = {hilbertIndex(x, y), node};
+        }
+        std::sort(keys.begin(), keys.end());
+        for (const auto &key : keys)
+        {
+            result.push_back(key.second);
+        }
+        return result;
+    }
+
+    const CsrGraph reverse = reverseGraph(g);
+    const CsrView back = reverse.view();
+    auto degree = [&](std::uint32_t node) { return g.degree(node) + back.degree(node); };
+    auto forEachNeighbor = [&](std::uint32_t node, auto &&visit)
+    {
+        for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+        {
+            visit(g.targets[edge]);
+        }
+        for (std::uint32_t edge = back.firstEdge(node); edge < back.lastEdge(node); ++edge)
+        {
+            visit(back.targets[edge]);
+        }
+    };
+
+    std::vector<char> placed(g.nodeCount, 0);
+    if (order == NodeOrder::Bfs)
+    {
+        for (std::uint32_t start = 0; start < g.nodeCount; ++start)
+        {
+            if (placed[start])
+            {
+                continue;
+            }
+            placed[start] = 1;
+            // result doubles as the BFS queue: everything after head is waiting to be expanded.
+            std::size_t head = result.size();
+            result.push_back(start);
+            while (head < result.size())
+            {
+                forEachNeighbor(result[head++],
+                                [&](std::uint32_t next)
+                                {
+                                    if (!placed[next])
+                                    {
+                                        placed[next] = 1;
+                                        result.push_back(next);
+                                    }
+                                });
+            }
+        }
+        return result;
+    }
+
+    // Reverse Cuthill-McKee. seen marks the nodes of the current peripheral-node search (by stamp).
+    std::vector<std::uint32_t> seen(g.nodeCount, 0);
+    std::uint32_t stamp = 0;
+    std::vector<std::uint32_t> level;
+    auto lastLevel = [&](std::uint32_t root, std::vector<std::uint32_t> &last)
+    {
+        // BFS over the unplaced component of root; returns its depth and leaves the deepest nodes in last.
+        ++stamp;
+        level.assign(1, root);
+        seen[root] = stamp;
+        std::uint32_t depth = 0;
+        while (true)
+        {
+            last.swap(level);
+            level.clear();
+            for (std::uint32_t node : last)
+            {
+                forEachNeighbor(node,
+                                [&](std::uint32_t next)
+                                {
+                                    if (!placed[next] && seen[next] != stamp)
+                                    {
+                                        seen[next] = stamp;
+                                        level.push_back(next);
+                                    }
+                                });
+            }
+            if (level.empty())
+            {
+                return depth;
+            }
+            depth++;
+        }
+    };
+
+    std::vector<std::uint32_t> last;
+    std::vector<std::uint32_t> neighbors;
+    for (std::uint32_t start = 0; start < g.nodeCount; ++start)
+    {
+        if (placed[start])
+        {
+            continue;
+        }
+        // George-Liu: hop to a low-degree node of the deepest level while that makes the BFS deeper.
+        std::uint32_t root = start;
+        std::uint32_t depth = lastLevel(root, last);
+        for (int round = 0; round < 8; ++round)
+        {
+            std::uint32_t candidate = *std::min_element(last.begin(), last.end(),
+                                                        [&](std::uint32_t a, std::uint32_t b)
+                                                        { return degree(a) < degree(b); });
+            std::uint32_t candidateDepth = lastLevel(candidate, last);
+            if (candidateDepth <= depth)
+            {
+                break;
+            }
+            root = candidate;
+            depth = candidateDepth;
+        }
+
+        placed[root] = 1;
+        std::size_t head = result.size();
+        result.push_back(root);
+        while (head < result.size())
+        {
+            neighbors.clear();
+            forEachNeighbor(result[head++],
+                            [&](std::uint32_t next)
+                            {
+                                if (!placed[next])
+                                {
+                                    placed[next] = 1;
+                                    neighbors.push_back(next);
+                                }
+                            });
+            std::sort(neighbors.begin(), neighbors.end(),
+                      [&](std::uint32_t a, std::uint32_t b)
+                      { return degree(a) != degree(b) ? degree(a) < degree(b) : a < b; });
+            result.insert(result.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief A graph renumbered for locality, with the maps between its ids and the original ones.
+ *
+ * Engines run on graph and only ever see internal ids; callers keep using the ids of their data
+ * (external ids) and translate at the edges with internal() and external(), or let RenumberedSearch
+ * do it. Labels and coordinates are permuted with the nodes, so graph.idOf() and the heuristics keep
+ * working unchanged.
+ */
+class ReorderedGraph
+{
+public:
+    CsrGraph graph;                        ///< Renumbered graph.
+    std::vector<std::uint32_t> toInternal; ///< [external id] = internal id.
+    std::vector<std::uint32_t> toExternal; ///< [internal id] = external id.
+
+    std::uint32_t internal(std::uint32_t node) const { return node == NO_NODE ? NO_NODE : toInternal[node]; }
+    std::uint32_t external(std::uint32_t node) const { return node == NO_NODE ? NO_NODE : toExternal[node]; }
+
+    /**
+     * @brief Rewrites internal ids (e.g. a path) as external ids, in place.
+     */
+    void toExternalIds(std::uint32_t *nodes, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            nodes[i] = external(nodes[i]);
+        }
+    }
+};
+
+/**
+ * @brief Renumbers a graph: node toExternal[i] becomes node i, and every per-node array follows.
+ *
+ * The rows are rebuilt in the new order and the edges of each row sorted by new target id, so a
+ * relaxation sweeps a short, mostly ascending range of the distance array instead of random cache lines.
+ *
+ * @param g Graph to renumber (e.g. a MappedGraph view, right after loading).
+ * @param order Numbering to use.
+ * @param labels nodeCount character names to carry over, or nullptr.
+ */
+inline ReorderedGraph reorderGraph(CsrView g, NodeOrder order, const char *labels = nullptr)
+{
+    ReorderedGraph result;
+    result.toExternal = computeNodeOrder(g, order);
+    result.toInternal.assign(g.nodeCount, NO_NODE);
+    for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+    {
+        result.toInternal[result.toExternal[node]] = node;
+    }
+
+    CsrGraph &r = result.graph;
+    r.offsets.assign(static_cast<std::size_t>(g.nodeCount) + 1, 0);
+    r.targets.resize(g.edgeCount);
+    r.weights.resize(g.edgeCount);
+    std::vector<std::pair<std::uint32_t, float>> row;
+    for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+    {
+        std::uint32_t old = result.toExternal[node];
+        row.clear();
+        for (std::uint32_t edge = g.firstEdge(old); edge < g.lastEdge(old); ++edge)
+        {
+            row.push_back({result.toInternal[g.targets[edge]], g.weights[edge]});
+        }
+        // Stable, so parallel edges keep their relative order.
+        std::stable_sort(row.begin(), row.end(),
+                         [](const std::pair<std::uint32_t, float> &a, const std::pair<std::uint32_t, float> &b)
+                         { return a.first < b.first; });
+        std::uint32_t slot = r.offsets[node];
+        for (const auto &edge : row)
+        {
+            r.targets[slot] = edge.first;
+            r.weights[slot] = edge.second;
+            slot++;
+        }
+        r.offsets[node + 1] = slot;
+    }
+    if (g.coordinates != nullptr)
+    {
+        r.coordinates.resize(g.nodeCount);
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            r.coordinates[node] = g.coordinates[result.toExternal[node]];
+        }
+    }
+    if (labels != nullptr)
+    {
+        r.labels.resize(g.nodeCount);
+        for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+        {
+            r.labels[node] = labels[result.toExternal[node]];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Renumbers an in-memory graph, with its labels and coordinates.
+ */
+inline ReorderedGraph reorderGraph(const CsrGraph &g, NodeOrder order)
+{
+    return reorderGraph(g.view(), order, g.labels.empty() ? nullptr : g.labels.data());
+}
+
+/**
+ * @brief A CsrDijkstra-style engine on a renumbered graph that speaks external ids.
+ *
+ * Sources, targets and the nodes passed to distance() are translated on the way in, predecessors and
+ * paths on the way out, so callers never see the internal numbering. Translating costs one array read
+ * per id, nothing per relaxed edge.
+ *
+ * @tparam Engine CsrDijkstra (or DistanceOnlyDijkstra, without the path functions) instance.
+ */
+template <typename Engine = CsrDijkstra<>>
+class RenumberedSearch
+{
+public:
+    /**
+     * @brief Creates an engine for the given graph. The graph must outlive the engine.
+     */
+    explicit RenumberedSearch(const ReorderedGraph &g) : ids(&g), engine(g.graph.view()) {}
+
+    void run(std::uint32_t source, std::uint32_t target = NO_NODE)
+    {
+        engine.run(ids->internal(source), ids->internal(target));
+    }
+
+    float distance(std::uint32_t node) const { return engine.distance(ids->internal(node)); }
+
+    std::uint32_t predecessor(std::uint32_t node) const
+    {
+        return ids->external(engine.predecessor(ids->internal(node)));
+    }
+
+    std::uint32_t settledCount() const { return engine.settledCount(); }
+
+    std::vector<std::uint32_t> path(std::uint32_t target) const
+    {
+        std::vector<std::uint32_t> result;
+        pathInto(target, result);
+        return result;
+    }
+
+    /**
+     * @brief Same contract as CsrDijkstra::pathInto(), with external ids.
+     */
+    std::size_t pathInto(std::uint32_t target, std::uint32_t *out, std::size_t capacity) const
+    {
+        std::size_t length = engine.pathInto(ids->internal(target), out, capacity);
+        if (length <= capacity)
+        {
+            ids->toExternalIds(out, length);
+        }
+        return length;
+    }
+
+    void pathInto(std::uint32_t target, std::vector<std::uint32_t> &out) const
+    {
+        engine.pathInto(ids->internal(target), out);
+        ids->toExternalIds(out.data(), out.size());
+    }
+
+    /**
+     * @brief The wrapped engine, which works in internal ids.
+     */
+    Engine &inner() { return engine; }
+    const Engine &inner() const { return engine; }
+
+private:
+    const ReorderedGraph *ids; ///< Graph and id maps.
+    Engine engine;             ///< Search over the renumbered graph.
+};
+
+#endif // GRAPH_REORDER_HPP_
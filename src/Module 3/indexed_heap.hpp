@@ -0,0 +1,493 @@
+#ifndef INDEXED_HEAP_HPP_
+#define INDEXED_HEAP_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Entry stored in a priority-queue frontier: a node identifier and its tentative distance.
+ *
+ * Entries are ordered by key first and by id second, so two nodes with the same distance always come
+ * out in the same order (smallest id first). That matches the order in which the reference linear scan
+ * picks nodes, which lets every frontier produce exactly the same settle order and the same paths.
+ */
+template <typename Key>
+struct HeapEntry
+{
+    Key key;          ///< Tentative distance of the node.
+    std::uint32_t id; ///< Dense identifier of the node.
+};
+
+/**
+ * @brief Strict ordering of heap entries by (key, id).
+ */
+template <typename Key>
+inline bool heapBefore(const HeapEntry<Key> &a, const HeapEntry<Key> &b)
+{
+    return a.key < b.key || (!(b.key < a.key) && a.id < b.id);
+}
+
+/**
+ * @brief Addressable d-ary min-heap with decrease-key.
+ *
+ * Every node id owns one slot in a position table, so pushing a node that is already queued lowers its
+ * key in place instead of adding a duplicate. Wider heaps (Arity = 4) are shallower and touch fewer cache
+ * lines per sift-down, which usually wins on graphs where pops dominate.
+ *
+ * Ids must be smaller than the capacity given to reserve().
+ *
+ * @tparam Arity Number of children per heap node (2 = binary heap, 4 = quaternary heap).
+ * @tparam Key Type of the priorities.
+ */
+template <unsigned Arity, typename Key = float>
+class IndexedDaryHeap
+{
+    static_assert(Arity >= 2, "A heap needs at least two children per node.");
+
+public:
+    using Entry = HeapEntry<Key>;
+
+    static constexpr std::uint32_t NOT_IN_HEAP = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief Creates a heap able to hold ids in [0, capacity).
+     */
+    explicit IndexedDaryHeap(std::size_t capacity = 0) : position(capacity, NOT_IN_HEAP) {}
+
+    /**
+     * @brief Grows the position table so ids in [0, capacity) can be queued.
+     */
+    void reserve(std::size_t capacity)
+    {
+        if (position.size() < capacity)
+        {
+            position.resize(capacity, NOT_IN_HEAP);
+        }
+        entries.reserve(capacity);
+    }
+
+    bool empty() const { return entries.empty(); }
+    std::size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Tells whether the node is currently queued.
+     */
+    bool contains(std::uint32_t id) const { return position[id] != NOT_IN_HEAP; }
+
+    /**
+     * @brief Inserts a node or lowers its key if it is already queued.
+     *
+     * @return true if the heap changed, false if the node was queued with a key that is not larger.
+     */
+    bool push(std::uint32_t id, Key key)
+    {
+        assert(id < position.size());
+        std::uint32_t slot = position[id];
+        if (slot == NOT_IN_HEAP)
+        {
+            entries.push_back({key, id});
+            siftUp(static_cast<std::uint32_t>(entries.size() - 1));
+            return true;
+        }
+        if (!(key < entries[slot].key))
+        {
+            return false;
+        }
+        entries[slot].key = key;
+        siftUp(slot);
+        return true;
+    }
+
+    /**
+     * @brief Entry with the smallest key. The heap must not be empty.
+     */
+    const Entry &top() const { return entries.front(); }
+
+    /**
+     * @brief Removes the entry with the smallest key.
+     *
+     * @param id Receives the node identifier.
+     * @param key Receives the node's key.
+     * @return false if the heap was empty.
+     */
+    bool pop(std::uint32_t &id, Key &key)
+    {
+        if (entries.empty())
+        {
+            return false;
+        }
+        id = entries.front().id;
+        key = entries.front().key;
+        position[id] = NOT_IN_HEAP;
+        Entry last = entries.back();
+        entries.pop_back();
+        if (!entries.empty())
+        {
+            entries.front() = last;
+            siftDown(0);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Empties the heap. Costs O(size), not O(capacity).
+     */
+    void clear()
+    {
+        for (const Entry &entry : entries)
+        {
+            position[entry.id] = NOT_IN_HEAP;
+        }
+        entries.clear();
+    }
+
+private:
+    std::vector<Entry> entries;          ///< Heap-ordered entries.
+    std::vector<std::uint32_t> position; ///< Slot of each id inside entries, or NOT_IN_HEAP.
+
+    void siftUp(std::uint32_t slot)
+    {
+        Entry moving = entries[slot];
+        while (slot > 0)
+        {
+            std::uint32_t parent = (slot - 1) / Arity;
+            if (!heapBefore(moving, entries[parent]))
+            {
+                break;
+            }
+            entries[slot] = entries[parent];
+            position[entries[slot].id] = slot;
+            slot = parent;
+        }
+        entries[slot] = moving;
+        position[moving.id] = slot;
+    }
+
+    void siftDown(std::uint32_t slot)
+    {
+        Entry moving = entries[slot];
+        const std::uint32_t count = static_cast<std::uint32_t>(entries.size());
+        while (true)
+        {
+            std::uint32_t first = slot * Arity + 1;
+            if (first >= count)
+            {
+                break;
+            }
+            std::uint32_t last = std::min(first + Arity, count);
+            std::uint32_t best = first;
+            for (std::uint32_t child = first + 1; child < last; ++child)
+            {
+                if (heapBefore(entries[child], entries[best]))
+                {
+                    best = child;
+                }
+            }
+            if (!heapBefore(entries[best], moving))
+            {
+                break;
+            }
+            entries[slot] = entries[best];
+            position[entries[slot].id] = slot;
+            slot = best;
+        }
+        entries[slot] = moving;
+        position[moving.id] = slot;
+    }
+};
+
+/**
+ * @brief Binary min-heap with lazy deletion.
+ *
+ * There is no decrease-key: an improved node is simply pushed again and the outdated copy stays in the
+ * heap until it is popped. The caller skips those copies by checking whether the node was already
+ * settled. Cheaper bookkeeping than the indexed heap, at the price of a larger heap.
+ *
+ * @tparam Key Type of the priorities.
+ */
+template <typename Key = float>
+class LazyBinaryHeap
+{
+public:
+    using Entry = HeapEntry<Key>;
+
+    explicit LazyBinaryHeap(std::size_t capacity = 0) { entries.reserve(capacity); }
+
+    void reserve(std::size_t capacity) { entries.reserve(capacity); }
+
+    bool empty() const { return entries.empty(); }
+    std::size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Queues a (node, key) pair. Older copies of the node are left in place.
+     *
+     * @return Always true: the heap always changes.
+     */
+    bool push(std::uint32_t id, Key key)
+    {
+        entries.push_back({key, id});
+        std::push_heap(entries.begin(), entries.end(), after);
+        return true;
+    }
+
+    /**
+     * @brief Entry with the smallest key (possibly an outdated copy). The heap must not be empty.
+     */
+    const Entry &top() const { return entries.front(); }
+
+    /**
+     * @brief Removes the entry with the smallest key. It may be an outdated copy.
+     */
+    bool pop(std::uint32_t &id, Key &key)
+    {
+        if (entries.empty())
+        {
+            return false;
+        }
+        std::pop_heap(entries.begin(), entries.end(), after);
+        id = entries.back().id;
+        key = entries.back().key;
+        entries.pop_back();
+        return true;
+    }
+
+    void clear() { entries.clear(); }
+
+private:
+    std::vector<Entry> entries; ///< Heap-ordered entries (smallest on top).
+
+    static bool after(const Entry &a, const Entry &b) { return heapBefore(b, a); }
+};
+
+/**
+ * @brief Dial's bucket queue for non-negative integer keys.
+ *
+ * One bucket per key value, kept in a circular array: push appends to the bucket of its key and pop takes
+ * from the first non-empty bucket at or after the last popped key, so both are O(1) apart from stepping
+ * over empty buckets. That needs monotone keys, which Dijkstra guarantees: nothing pushed is smaller than
+ * the key last popped, and nothing is more than the largest edge weight above it. The array holds a power
+ * of two buckets covering that span; it grows by itself the first time a wider span shows up, so it ends
+ * up about as large as the largest edge weight. Best with small integer weights (up to a few thousand);
+ * a span of MAX_SPAN or more is refused with std::length_error rather than allocating a ring that large.
+ *
+ * Like LazyBinaryHeap there is no decrease-key: improved nodes are pushed again and the caller skips the
+ * outdated copies. Entries with the same key come out last pushed first, so among several equally short
+ * paths it may settle a different one than the heaps do; the distances are the same.
+ *
+ * @tparam Key Unsigned or non-negative integer type of the priorities.
+ */
+template <typename Key = std::uint32_t>
+class BucketQueue
+{
+    static_assert(std::is_integral<Key>::value, "The bucket queue needs integer keys.");
+
+public:
+    using Entry = HeapEntry<Key>;
+
+    static constexpr std::uint64_t MAX_SPAN = std::uint64_t(1) << 20; ///< Widest key span the ring may cover.
+
+    explicit BucketQueue(std::size_t = 0) : buckets(1) {}
+
+    /**
+     * @brief Nothing to size per id: buckets grow with the key span, not with the node count.
+     */
+    void reserve(std::size_t) {}
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    /**
+     * @brief Queues a (node, key) pair.
+     *
+     * The key must not be smaller than the last popped key, nor than the first key pushed since
+     * construction or clear() (in Dijkstra, the source at distance 0), nor MAX_SPAN or more above the
+     * smallest key that may still be queued (std::length_error).
+     *
+     * @return Always true: the queue always changes.
+     */
+    bool push(std::uint32_t id, Key key)
+    {
+        if (fresh)
+        {
+            current = key;
+            fresh = false;
+        }
+        assert(!(key < current));
+        std::uint64_t span = static_cast<std::uint64_t>(key - current);
+        if (span >= buckets.size())
+        {
+            grow(span);
+        }
+        buckets[bucketOf(key)].push_back(id);
+        count++;
+        return true;
+    }
+
+    /**
+     * @brief Entry with the smallest key (possibly an outdated copy). The queue must not be empty.
+     */
+    Entry top() const
+    {
+        advance();
+        return {current, buckets[bucketOf(current)].back()};
+    }
+
+    /**
+     * @brief Removes an entry with the smallest key. It may be an outdated copy.
+     */
+    bool pop(std::uint32_t &id, Key &key)
+    {
+        if (count == 0)
+        {
+            return false;
+        }
+        advance();
+        std::vector<std::uint32_t> &bucket = buckets[bucketOf(current)];
+        id = bucket.back();
+        key = current;
+        bucket.pop_back();
+        count--;
+        return true;
+    }
+
+    /**
+     * @brief Empties the queue. Costs O(buckets); the buckets keep their memory for the next run.
+     */
+    void clear()
+    {
+        for (std::vector<std::uint32_t> &bucket : buckets)
+        {
+            bucket.clear();
+        }
+        count = 0;
+        fresh = true;
+    }
+
+private:
+    std::vector<std::vector<std::uint32_t>> buckets; ///< Ids queued under each key, modulo buckets.size().
+    mutable Key current = 0;                         ///< Smallest key that may still be queued.
+    std::size_t count = 0;                           ///< Queued entries.
+    bool fresh = true;                               ///< No key pushed since construction or clear().
+
+    std::size_t bucketOf(Key key) const { return static_cast<std::size_t>(key) & (buckets.size() - 1); }
+
+    void advance() const
+    {
+        while (buckets[bucketOf(current)].empty())
+        {
+            current++;
+        }
+    }
+
+    /**
+     * @brief Enlarges the ring to the next power of two above span and moves every queued id.
+     *
+     * The cap keeps both the allocation and the doubling bounded: without it a 64-bit span of 2^63 would
+     * wrap size around to 0 and never end.
+     */
+    void grow(std::uint64_t span)
+    {
+        if (span >= MAX_SPAN)
+        {
+            throw std::length_error("BucketQueue: key span too wide; use a heap frontier for large weights");
+        }
+        std::size_t size = buckets.size();
+        while (size <= span)
+        {
+            size *= 2;
+        }
+        std::vector<std::vector<std::uint32_t>> wider(size);
+        for (std::size_t offset = 0; offset < buckets.size(); ++offset)
+        {
+            // Every queued key lies in [current, current + buckets.size()), one key per bucket.
+            Key key = static_cast<Key>(current + offset);
+            wider[static_cast<std::size_t>(key) & (size - 1)].swap(buckets[bucketOf(key)]);
+        }
+        buckets.swap(wider);
+    }
+};
+
+using BinaryHeap = IndexedDaryHeap<2>;     ///< Binary heap with decrease-key.
+using QuaternaryHeap = IndexedDaryHeap<4>; ///< 4-ary heap with decrease-key.
+using LazyHeap = LazyBinaryHeap<>;         ///< Binary heap with lazy deletion.
+
+/**
+ * @brief Frontier tag: BucketQueue for integer weights of at most 16 bits, BinaryHeap otherwise.
+ *
+ * The width of a wider integer type says nothing about the size of the costs (uint32 weights may be 10^9),
+ * and the bucket queue needs about one bucket per unit of the largest weight, so those get the heap. Use
+ * SmallWeight when the costs are known to be small.
+ */
+struct AutoFrontier
+{
+};
+
+/**
+ * @brief Frontier tag promising that no edge weight exceeds MaxWeight: BucketQueue for integer weights,
+ * BinaryHeap otherwise.
+ *
+ * @tparam MaxWeight Largest edge weight; must stay below BucketQueue<>::MAX_SPAN.
+ */
+template <std::uint64_t MaxWeight = 4096>
+struct SmallWeight
+{
+};
+
+/**
+ * @brief The frontier an engine with Weight distances actually uses when asked for Frontier.
+ *
+ * The heap aliases above are declared with float keys; an engine with another weight type takes the same
+ * heap with its own key type, so Dijkstra<BinaryHeap, NoTrace, std::uint64_t> compares 64-bit integers.
+ * AutoFrontier and SmallWeight pick the bucket queue for integer weights known to be small (see both).
+ * Anything else is used as it is.
+ */
+template <typename Frontier, typename Weight>
+struct FrontierRebind
+{
+    using type = Frontier;
+};
+
+template <unsigned Arity, typename Key, typename Weight>
+struct FrontierRebind<IndexedDaryHeap<Arity, Key>, Weight>
+{
+    using type = IndexedDaryHeap<Arity, Weight>;
+};
+
+template <typename Key, typename Weight>
+struct FrontierRebind<LazyBinaryHeap<Key>, Weight>
+{
+    using type = LazyBinaryHeap<Weight>;
+};
+
+template <typename Key, typename Weight>
+struct FrontierRebind<BucketQueue<Key>, Weight>
+{
+    using type = BucketQueue<Weight>;
+};
+
+template <typename Weight>
+struct FrontierRebind<AutoFrontier, Weight>
+{
+    using type = typename std::conditional<std::is_integral<Weight>::value && sizeof(Weight) <= 2,
+                                           BucketQueue<Weight>, IndexedDaryHeap<2, Weight>>::type;
+};
+
+template <std::uint64_t MaxWeight, typename Weight>
+struct FrontierRebind<SmallWeight<MaxWeight>, Weight>
+{
+    static_assert(MaxWeight < BucketQueue<>::MAX_SPAN, "SmallWeight: bound too large for the bucket queue.");
+
+    using type = typename std::conditional<std::is_integral<Weight>::value, BucketQueue<Weight>,
+                                           IndexedDaryHeap<2, Weight>>::type;
+};
+
+template <typename Frontier, typename Weight>
+using FrontierFor = typename FrontierRebind<Frontier, Weight>::type;
+
+#endif // INDEXED_HEAP_HPP_
@@ -0,0 +1,522 @@
+#ifndef LANDMARKS_HPP_
+#define LANDMARKS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "graph_file.hpp"
+#include "parallel.hpp"
+#include "synthetic_random.hpp"
+
+/**
+ * @brief How LandmarkTable::build() places its landmarks.
+ */
+enum class LandmarkStrategy
+{
+    Farthest, ///< Each new landmark is the node farthest from the ones already chosen.
+    Avoid     ///< Each new landmark lies in the region the current ones bound worst (Goldberg & Werneck).
+};
+
+/**
+ * @brief Tuning knobs for the landmark preprocessing step.
+ */
+struct LandmarkOptions
+{
+    std::uint32_t count = 16;                            ///< Number of landmarks (at most nodeCount).
+    LandmarkStrategy strategy = LandmarkStrategy::Avoid; ///< Placement strategy.
+    unsigned threads = 0;                                ///< Worker threads (0 = one per hardware thread).
+    std::uint64_t seed = 1;                              ///< Seed of the random roots used for placement.
+};
+
+/**
+ * @brief Fixed-size header at the start of a landmark file.
+ *
+ * The file is the header followed by the landmark ids (landmarkCount x u32), then the "from" and "to"
+ * tables (nodeCount x landmarkCount x f32 each), in the machine's native layout. graphChecksum ties the
+ * file to the graph it was computed on; checksum covers every byte after the header.
+ */
+struct LandmarkFileHeader
+{
+    char magic[8];               ///< "LANDMARK".
+    std::uint32_t version;       ///< LANDMARK_FILE_VERSION.
+    std::uint32_t landmarkCount; ///< Number of landmarks.
+    std::uint32_t nodeCount;     ///< Nodes of the graph.
+    std::uint32_t edgeCount;     ///< Edges of the graph.
+    std::uint64_t graphChecksum; ///< LandmarkTable::fingerprint() of the graph.
+    std::uint64_t checksum;      ///< Checksum of the bytes after the header.
+};
+
+constexpr std::uint32_t LANDMARK_FILE_VERSION = 1;
+constexpr char LANDMARK_FILE_MAGIC[8] = {'L', 'A', 'N', 'D', 'M', 'A', 'R', 'K'};
+
+/**
+ * @brief Landmark distance tables for ALT (A*, Landmarks, Triangle inequality) queries.
+ *
+ * For a few landmark nodes L the table stores d(L, v) and d(v, L) for every node v. By the triangle
+ * inequality, d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L), so the largest of these
+ * differences over all landmarks is a lower bound of the remaining distance that A* can use on any graph,
+ * with or without coordinates. Preprocessing is 2k full Dijkstra searches, far cheaper than a contraction
+ * hierarchy, and the bound is consistent, so A* never reopens a node.
+ *
+ * The tables are stored node-major (the k values of a node are adjacent), so one bound reads four short
+ * contiguous rows. Distances that are infinite (a node the landmark cannot reach, or that cannot reach
+ * it) are skipped by the bound. The bound is exact up to float rounding of the stored distances.
+ */
+class LandmarkTable
+{
+public:
+    std::vector<std::uint32_t> landmarks; ///< Landmark node ids, in placement order.
+    std::vector<float> fromLandmark;      ///< [node * landmarkCount() + i] = d(landmarks[i], node).
+    std::vector<float> toLandmark;        ///< [node * landmarkCount() + i] = d(node, landmarks[i]).
+    std::uint32_t edgeCount = 0;          ///< Edges of the graph the tables were computed on.
+    std::uint64_t graphChecksum = 0;      ///< fingerprint() of that graph.
+
+    std::uint32_t landmarkCount() const { return static_cast<std::uint32_t>(landmarks.size()); }
+
+    std::uint32_t nodeCount() const
+    {
+        return landmarks.empty() ? 0 : static_cast<std::uint32_t>(fromLandmark.size() / landmarks.size());
+    }
+
+    /**
+     * @brief Places the landmarks and computes both distance tables.
+     *
+     * With Farthest, placement only needs one forward search per landmark, and then all 2k table rows are
+     * computed in parallel. Avoid looks at the bounds of the landmarks already chosen, so it computes the
+     * two rows of every landmark (in parallel) before placing the next one.
+     *
+     * @param g Graph to preprocess (weights must be non-negative).
+     * @param options Landmark count, strategy, threads and seed.
+     */
+    static LandmarkTable build(CsrView g, const LandmarkOptions &options = LandmarkOptions())
+    {
+        LandmarkTable table;
+        Builder builder(g, options, table);
+        builder.run();
+        return table;
+    }
+
+    /**
+     * @brief Lower bound of d(node, target) from the triangle inequality (0 if no landmark helps).
+     */
+    float lowerBound(std::uint32_t node, std::uint32_t target) const
+    {
+        const std::size_t k = landmarks.size();
+        const float *fromNode = fromLandmark.data() + node * k;
+        const float *fromTarget = fromLandmark.data() + target * k;
+        const float *toNode = toLandmark.data() + node * k;
+        const float *toTarget = toLandmark.data() + target * k;
+        float bound = 0.0f;
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            if (fromNode[i] != INFINITY_VALUE && fromTarget[i] != INFINITY_VALUE)
+            {
+                bound = std::max(bound, fromTarget[i] - fromNode[i]);
+            }
+            if (toNode[i] != INFINITY_VALUE && toTarget[i] != INFINITY_VALUE)
+            {
+                bound = std::max(bound, toNode[i] - toTarget[i]);
+            }
+        }
+        return bound;
+    }
+
+    /**
+     * @brief Checksum of the arrays of a graph, to make sure a saved table is loaded for the same graph.
+     */
+    static std::uint64_t fingerprint(CsrView g)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        hash = hashBytes(g.offsets, g.offsets == nullptr ? 0 : (std::size_t(g.nodeCount) + 1) * 4, hash);
+        hash = hashBytes(g.targets, std::size_t(g.edgeCount) * 4, hash);
+        return hashBytes(g.weights, std::size_t(g.edgeCount) * 4, hash);
+    }
+
+    /**
+     * @brief Writes the table to a landmark file (see LandmarkFileHeader).
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void save(const std::string &path) const
+    {
+        LandmarkFileHeader header = {};
+        std::memcpy(header.magic, LANDMARK_FILE_MAGIC, sizeof(header.magic));
+        header.version = LANDMARK_FILE_VERSION;
+        header.landmarkCount = landmarkCount();
+        header.nodeCount = nodeCount();
+        header.edgeCount = edgeCount;
+        header.graphChecksum = graphChecksum;
+        header.checksum = payloadChecksum();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("cannot create landmark file " + path);
+        }
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(landmarks.data()),
+                  static_cast<std::streamsize>(landmarks.size() * sizeof(std::uint32_t)));
+        out.write(reinterpret_cast<const char *>(fromLandmark.data()),
+                  static_cast<std::streamsize>(fromLandmark.size() * sizeof(float)));
+        out.write(reinterpret_cast<const char *>(toLandmark.data()),
+                  static_cast<std::streamsize>(toLandmark.size() * sizeof(float)));
+        if (!out.flush())
+        {
+            throw std::runtime_error("cannot write landmark file " + path);
+        }
+    }
+
+    /**
+     * @brief Reads a landmark file saved for graph g.
+     *
+     * @throws std::runtime_error if the file cannot be read, is damaged, or was computed on another graph
+     *         (different size or arrays): the caller should then build() and save() again.
+     */
+    static LandmarkTable load(const std::string &path, CsrView g)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error("cannot open landmark file " + path);
+        }
+        LandmarkFileHeader header;
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, LANDMARK_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != LANDMARK_FILE_VERSION)
+        {
+            throw std::runtime_error("not a valid landmark file: " + path);
+        }
+        if (header.nodeCount != g.nodeCount || header.edgeCount != g.edgeCount ||
+            header.graphChecksum != fingerprint(g))
+        {
+            throw std::runtime_error("landmark file computed on another graph: " + path);
+        }
+        // Check the header against the file size before sizing the tables from it: a damaged count must not
+        // turn into a huge allocation. Divided rather than multiplied out, so nothing can overflow.
+        in.seekg(0, std::ios::end);
+        std::uint64_t payload = static_cast<std::uint64_t>(in.tellg()) - sizeof(header);
+        std::uint64_t idBytes = std::uint64_t(header.landmarkCount) * sizeof(std::uint32_t);
+        if (!in || header.landmarkCount > header.nodeCount || payload < idBytes ||
+            (payload - idBytes) % (2 * sizeof(float)) != 0 ||
+            (payload - idBytes) / (2 * sizeof(float)) != std::uint64_t(header.nodeCount) * header.landmarkCount)
+        {
+            throw std::runtime_error("damaged landmark file: " + path);
+        }
+        in.seekg(sizeof(header));
+
+        LandmarkTable table;
+        table.edgeCount = header.edgeCount;
+        table.graphChecksum = header.graphChecksum;
+        table.landmarks.resize(header.landmarkCount);
+        table.fromLandmark.resize(std::size_t(header.nodeCount) * header.landmarkCount);
+        table.toLandmark.resize(table.fromLandmark.size());
+        in.read(reinterpret_cast<char *>(table.landmarks.data()),
+                static_cast<std::streamsize>(table.landmarks.size() * sizeof(std::uint32_t)));
+        in.read(reinterpret_cast<char *>(table.fromLandmark.data()),
+                static_cast<std::streamsize>(table.fromLandmark.size() * sizeof(float)));
+        in.read(reinterpret_cast<char *>(table.toLandmark.data()),
+                static_cast<std::streamsize>(table.toLandmark.size() * sizeof(float)));
+        if (!in || in.peek() != std::ifstream::traits_type::eof() || table.payloadChecksum() != header.checksum)
+        {
+            throw std::runtime_error("damaged landmark file: " + path);
+        }
+        return table;
+    }
+
+private:
+    /**
+     * @brief graphFileChecksum() over data, with the last partial word zero-padded.
+     */
+    static std::uint64_t hashBytes(const void *data, std::size_t size, std::uint64_t hash)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        std::size_t whole = size / 8 * 8;
+        hash = graphFileChecksum(bytes, whole, hash);
+        if (whole < size)
+        {
+            unsigned char tail[8] = {};
+            std::memcpy(tail, bytes + whole, size - whole);
+            hash = graphFileChecksum(tail, 8, hash);
+        }
+        return hash;
+    }
+
+    std::uint64_t payloadChecksum() const
+    {
+        std::uint64_t hash = hashBytes(landmarks.data(), landmarks.size() * sizeof(std::uint32_t),
+                                       0xcbf29ce484222325ull);
+        hash = hashBytes(fromLandmark.data(), fromLandmark.size() * sizeof(float), hash);
+        return hashBytes(toLandmark.data(), toLandmark.size() * sizeof(float), hash);
+    }
+
+    /**
+     * @brief State of one build() call: the reverse graph and one pair of searches per thread.
+     */
+    class Builder
+    {
+    public:
+        Builder(CsrView g, const LandmarkOptions &o, LandmarkTable &result)
+            : graph(g), reverse(reverseGraph(g)), options(o), random(o.seed),
+              count(std::min(o.count, g.nodeCount)), isLandmark(g.nodeCount, 0), table(result)
+        {
+            unsigned threads = resolveThreadCount(options.threads);
+            for (unsigned i = 0; i < threads; ++i)
+            {
+                forward.emplace_back(new DistanceOnlyDijkstra<>(graph));
+                backward.emplace_back(new DistanceOnlyDijkstra<>(reverse.view()));
+            }
+            table.edgeCount = g.edgeCount;
+            table.graphChecksum = fingerprint(g);
+            table.landmarks.reserve(count);
+            table.fromLandmark.assign(std::size_t(g.nodeCount) * count, INFINITY_VALUE);
+            table.toLandmark.assign(table.fromLandmark.size(), INFINITY_VALUE);
+        }
+
+        void run()
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            if (options.strategy == LandmarkStrategy::Farthest)
+            {
+                placeFarthest();
+                computeRows(0, count);
+            }
+            else
+            {
+                placeAvoid();
+            }
+            // Placement may run out of candidates: store the tables with the final landmark count as stride.
+            if (table.landmarks.size() < count)
+            {
+                shrink();
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t MAX_FAILED_ROOTS = 64; ///< Roots without a free node before Avoid stops.
+
+        CsrView graph;                  ///< Graph being preprocessed.
+        CsrGraph reverse;               ///< Its reverse, for the "to landmark" searches.
+        LandmarkOptions options;        ///< Build settings.
+        SyntheticRandom random;         ///< Picks the roots of the placement searches.
+        std::uint32_t count;            ///< Landmarks to place (the table stride during the build).
+        std::vector<char> isLandmark;   ///< 1 for every node already chosen.
+        LandmarkTable &table;           ///< Result being filled.
+        std::vector<std::unique_ptr<DistanceOnlyDijkstra<>>> forward;  ///< One forward search per thread.
+        std::vector<std::unique_ptr<DistanceOnlyDijkstra<>>> backward; ///< One backward search per thread.
+
+        void choose(std::uint32_t node)
+        {
+            table.landmarks.push_back(node);
+            isLandmark[node] = 1;
+        }
+
+        /**
+         * @brief Fills the table columns of landmarks [begin, end): 2 searches per landmark, in parallel.
+         */
+        void computeRows(std::uint32_t begin, std::uint32_t end)
+        {
+            parallelFor(std::size_t(end - begin) * 2, options.threads, 1,
+                        [&](unsigned worker, std::size_t first, std::size_t last)
+                        {
+                            for (std::size_t task = first; task < last; ++task)
+                            {
+                                std::uint32_t column = begin + static_cast<std::uint32_t>(task / 2);
+                                bool outward = task % 2 == 0;
+                                DistanceOnlyDijkstra<> &search = outward ? *forward[worker] : *backward[worker];
+                                std::vector<float> &target = outward ? table.fromLandmark : table.toLandmark;
+                                search.run(table.landmarks[column]);
+                                for (std::uint32_t node = 0; node < graph.nodeCount; ++node)
+                                {
+                                    target[std::size_t(node) * count + column] = search.distance(node);
+                                }
+                            }
+                        });
+        }
+
+        /**
+         * @brief Farthest placement: start from the node farthest from a random root, then repeatedly take
+         *        the node whose distance to the nearest chosen landmark is largest.
+         *
+         * Nodes no chosen landmark reaches are not candidates, so islands do not soak up landmarks.
+         */
+        void placeFarthest()
+        {
+            DistanceOnlyDijkstra<> &search = *forward[0];
+            std::vector<float> nearest(graph.nodeCount, INFINITY_VALUE);
+            search.run(random.below(graph.nodeCount));
+            std::uint32_t next = farthest(search, nullptr);
+            while (next != NO_NODE && table.landmarks.size() < count)
+            {
+                choose(next);
+                search.run(next);
+                next = farthest(search, &nearest);
+            }
+        }
+
+        /**
+         * @brief Reached node with the largest distance (taking the minimum with nearest, if given, and
+         *        folding the current distances into it), excluding landmarks. NO_NODE if there is none.
+         */
+        std::uint32_t farthest(const DistanceOnlyDijkstra<> &search, std::vector<float> *nearest) const
+        {
+            std::uint32_t best = NO_NODE;
+            float bestDistance = -1.0f;
+            for (std::uint32_t node = 0; node < graph.nodeCount; ++node)
+            {
+                float distance = search.distance(node);
+                if (nearest != nullptr)
+                {
+                    distance = (*nearest)[node] = std::min((*nearest)[node], distance);
+                }
+                if (distance != INFINITY_VALUE && distance > bestDistance && !isLandmark[node])
+                {
+                    best = node;
+                    bestDistance = distance;
+                }
+            }
+            return best;
+        }
+
+        /**
+         * @brief Avoid placement.
+         *
+         * For a random root r, grow the shortest-path tree of r and give every node v the weight
+         * d(r, v) - bound(r, v): how much the current landmarks underestimate the way to it. A subtree's
+         * size is the sum of its weights, or 0 if it already holds a landmark. Starting at the node with
+         * the largest size, walk down to the child with the largest size until a leaf: that leaf becomes
+         * the next landmark, on the far side of the worst-covered region.
+         */
+        void placeAvoid()
+        {
+            CsrDijkstra<> tree(graph);
+            std::vector<ReachedNode> order;
+            std::vector<double> size(graph.nodeCount);
+            std::vector<char> covered(graph.nodeCount);
+            std::vector<std::uint32_t> heaviestChild(graph.nodeCount);
+            std::uint32_t failedRoots = 0;
+            while (table.landmarks.size() < count && failedRoots < MAX_FAILED_ROOTS)
+            {
+                std::uint32_t root = random.below(graph.nodeCount);
+                tree.runWithin(root, INFINITY_VALUE, order);
+                for (const ReachedNode &reached : order)
+                {
+                    size[reached.node] = reached.distance - boundSoFar(root, reached.node);
+                    covered[reached.node] = isLandmark[reached.node];
+                    heaviestChild[reached.node] = NO_NODE;
+                }
+                // Children are settled after their parent: a reverse sweep folds every subtree into it.
+                for (std::size_t i = order.size(); i-- > 1;)
+                {
+                    std::uint32_t node = order[i].node;
+                    std::uint32_t parent = tree.predecessor(node);
+                    if (parent == NO_NODE)
+                    {
+                        continue; // Only the root (order[0]) has none; this also tells GCC the index is valid.
+                    }
+                    size[parent] += size[node];
+                    covered[parent] |= covered[node];
+                    std::uint32_t &heaviest = heaviestChild[parent];
+                    if (!covered[node] && (heaviest == NO_NODE || size[node] > size[heaviest]))
+                    {
+                        heaviest = node;
+                    }
+                }
+                std::uint32_t best = NO_NODE;
+                for (const ReachedNode &reached : order)
+                {
+                    if (!covered[reached.node] && (best == NO_NODE || size[reached.node] > size[best]))
+                    {
+                        best = reached.node;
+                    }
+                }
+                if (best == NO_NODE)
+                {
+                    // Every branch from this root already ends at a landmark: fall back to its farthest node.
+                    for (std::size_t i = order.size(); i-- > 0 && best == NO_NODE;)
+                    {
+                        best = isLandmark[order[i].node] ? NO_NODE : order[i].node;
+                    }
+                    if (best == NO_NODE)
+                    {
+                        failedRoots++;
+                        continue;
+                    }
+                }
+                while (heaviestChild[best] != NO_NODE)
+                {
+                    best = heaviestChild[best];
+                }
+                choose(best);
+                computeRows(table.landmarkCount() - 1, table.landmarkCount());
+            }
+        }
+
+        /**
+         * @brief lowerBound() with the columns filled so far (the others are still infinite).
+         */
+        float boundSoFar(std::uint32_t node, std::uint32_t target) const
+        {
+            float bound = 0.0f;
+            for (std::uint32_t i = 0; i < table.landmarkCount(); ++i)
+            {
+                float fromNode = table.fromLandmark[std::size_t(node) * count + i];
+                float fromTarget = table.fromLandmark[std::size_t(target) * count + i];
+                float toNode = table.toLandmark[std::size_t(node) * count + i];
+                float toTarget = table.toLandmark[std::size_t(target) * count + i];
+                if (fromNode != INFINITY_VALUE && fromTarget != INFINITY_VALUE)
+                {
+                    bound = std::max(bound, fromTarget - fromNode);
+                }
+                if (toNode != INFINITY_VALUE && toTarget != INFINITY_VALUE)
+                {
+                    bound = std::max(bound, toNode - toTarget);
+                }
+            }
+            return bound;
+        }
+
+        /**
+         * @brief Repacks the tables when fewer landmarks than count could be placed.
+         */
+        void shrink()
+        {
+            std::uint32_t placed = table.landmarkCount();
+            for (std::vector<float> *column : {&table.fromLandmark, &table.toLandmark})
+            {
+                for (std::uint32_t node = 0; node < graph.nodeCount; ++node)
+                {
+                    std::copy_n(column->begin() + std::size_t(node) * count, placed,
+                                column->begin() + std::size_t(node) * placed);
+                }
+                column->resize(std::size_t(graph.nodeCount) * placed);
+            }
+            count = placed;
+        }
+    };
+};
+
+/**
+ * @brief A* heuristic backed by a LandmarkTable: AStar<LandmarkHeuristic> is an ALT query.
+ */
+struct LandmarkHeuristic
+{
+    const LandmarkTable *table; ///< Precomputed distances; must outlive the engine.
+
+    explicit LandmarkHeuristic(const LandmarkTable &landmarks) : table(&landmarks) {}
+
+    float operator()(std::uint32_t node, std::uint32_t target) const { return table->lowerBound(node, target); }
+};
+
+#endif // LANDMARKS_HPP_
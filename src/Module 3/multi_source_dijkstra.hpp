@@ -0,0 +1,150 @@
+#ifndef MULTI_SOURCE_DIJKSTRA_HPP_
+#define MULTI_SOURCE_DIJKSTRA_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "indexed_heap.hpp"
+#include "query_context.hpp"
+
+/**
+ * @brief Nearest-source search: one Dijkstra pass from many sources at once.
+ *
+ * All sources start in the frontier at distance 0, as if a virtual super-source had a zero-cost edge to
+ * each of them. When the search ends every reached node knows its distance to the closest source and
+ * which source that is, so "which depot is nearest to each customer" costs one search instead of one
+ * per depot. The nearest source is carried along the relaxations, no path has to be walked to find it.
+ *
+ * When two sources are exactly as far from a node, the node goes to the one whose path is settled
+ * first, which is deterministic for a given graph and source list. A source listed twice counts once
+ * (its first position).
+ *
+ * Like CsrDijkstra, the engine only keeps a view of the graph and reuses its buffers between runs.
+ *
+ * @tparam Frontier One of the heaps from indexed_heap.hpp.
+ */
+template <typename Frontier = BinaryHeap>
+class MultiSourceDijkstra
+{
+public:
+    /**
+     * @brief Creates an engine for the given graph. The graph must outlive the engine.
+     */
+    explicit MultiSourceDijkstra(CsrView g) : graph(g), frontier(g.nodeCount), state(g.nodeCount), origins(g.nodeCount)
+    {
+    }
+
+    /**
+     * @brief Computes, for every node reachable from a source, the nearest source and its distance.
+     *
+     * @param sources Starting nodes (e.g. depots). May be empty, then nothing is reached.
+     */
+    void run(const std::vector<std::uint32_t> &sources)
+    {
+        state.reset();
+        frontier.clear();
+        settledNodes = 0;
+        sourceNodes.assign(sources.begin(), sources.end());
+
+        for (std::uint32_t index = 0; index < sources.size(); ++index)
+        {
+            std::uint32_t source = sources[index];
+            if (!state.reached(source))
+            {
+                state.reach(source, 0.0f, NO_NODE);
+                origins[source] = index;
+                frontier.push(source, 0.0f);
+            }
+        }
+
+        std::uint32_t current;
+        float key;
+        while (frontier.pop(current, key))
+        {
+            if (state.isSettled(current))
+            {
+                continue; // Outdated copy left behind by a lazy heap.
+            }
+            state.settle(current);
+            settledNodes++;
+            relax(current, key);
+        }
+    }
+
+    /**
+     * @brief Distance from the nearest source, or INFINITY_VALUE if no source reaches the node.
+     */
+    float distance(std::uint32_t node) const { return state.distance(node); }
+
+    /**
+     * @brief Position in the source list of the nearest source, or NO_NODE.
+     */
+    std::uint32_t sourceIndex(std::uint32_t node) const { return state.reached(node) ? origins[node] : NO_NODE; }
+
+    /**
+     * @brief Nearest source node, or NO_NODE.
+     */
+    std::uint32_t nearestSource(std::uint32_t node) const
+    {
+        return state.reached(node) ? sourceNodes[origins[node]] : NO_NODE;
+    }
+
+    /**
+     * @brief Previous node on the path from the nearest source, or NO_NODE.
+     */
+    std::uint32_t predecessor(std::uint32_t node) const { return state.predecessor(node); }
+
+    /**
+     * @brief Number of nodes settled by the last run.
+     */
+    std::uint32_t settledCount() const { return settledNodes; }
+
+    /**
+     * @brief Search state of the last run (distances, predecessors, reached nodes).
+     */
+    const QueryContext &context() const { return state; }
+
+    /**
+     * @brief Shortest path from the nearest source to node, or an empty vector if no source reaches it.
+     */
+    std::vector<std::uint32_t> path(std::uint32_t node) const
+    {
+        std::vector<std::uint32_t> result;
+        state.writePath(node, result);
+        return result;
+    }
+
+private:
+    CsrView graph;                          ///< Graph being searched.
+    Frontier frontier;                      ///< Queue of reached, unsettled nodes.
+    QueryContext state;                     ///< Reusable per-node distances, predecessors and flags.
+    std::vector<std::uint32_t> origins;     ///< Source index of every reached node (valid when stamped).
+    std::vector<std::uint32_t> sourceNodes; ///< Sources of the last run.
+    std::uint32_t settledNodes = 0;         ///< Nodes settled by the last run.
+
+    /**
+     * @brief Relaxes every outgoing edge of a settled node; improved neighbors inherit its source.
+     */
+    void relax(std::uint32_t current, float base)
+    {
+        const std::uint32_t origin = origins[current];
+        for (std::uint32_t edge = graph.firstEdge(current); edge < graph.lastEdge(current); ++edge)
+        {
+            std::uint32_t next = graph.targets[edge];
+            if (state.isSettled(next))
+            {
+                continue;
+            }
+            float newDistance = base + graph.weights[edge];
+            if (newDistance < state.distance(next))
+            {
+                state.reach(next, newDistance, current);
+                origins[next] = origin;
+                frontier.push(next, newDistance);
+            }
+        }
+    }
+};
+
+#endif // MULTI_SOURCE_DIJKSTRA_HPP_
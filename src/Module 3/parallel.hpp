@@ -0,0 +1,251 @@
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Number of worker threads to use for a requested count (0 means "one per hardware thread").
+ */
+inline unsigned resolveThreadCount(unsigned requested)
+{
+    if (requested != 0)
+    {
+        return requested;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+/**
+ * @brief Runs body over [0, count) split in chunks of grain items, handed out dynamically to threads.
+ *
+ * Threads grab the next chunk from a shared counter when they finish the previous one, so uneven work
+ * (a long query next to a short one) still keeps every core busy. The calling thread works as worker 0.
+ *
+ * The threads are started and joined by this call, which is fine for one-off work such as building an
+ * index. Code that runs parallel loops over and over (query batches, search phases) uses a ThreadPool.
+ *
+ * @param count Number of items.
+ * @param threadCount Number of workers (0 = hardware threads).
+ * @param grain Items per chunk.
+ * @param body Callable as body(unsigned worker, std::size_t begin, std::size_t end).
+ */
+template <typename Body>
+void parallelFor(std::size_t count, unsigned threadCount, std::size_t grain, Body body)
+{
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (count + grain - 1) / grain;
+    unsigned workers = static_cast<unsigned>(std::min<std::size_t>(resolveThreadCount(threadCount), chunks));
+    if (workers <= 1)
+    {
+        if (count > 0)
+        {
+            body(0u, std::size_t(0), count);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto loop = [&](unsigned worker)
+    {
+        while (true)
+        {
+            std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count)
+            {
+                break;
+            }
+            body(worker, begin, std::min(begin + grain, count));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned worker = 1; worker < workers; ++worker)
+    {
+        pool.emplace_back(loop, worker);
+    }
+    loop(0);
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Fixed set of worker threads that stay parked between parallel loops.
+ *
+ * The threads are started once, by the constructor, and wait on a condition variable. parallelFor()
+ * publishes the loop, wakes them, works as worker 0 itself and returns once every chunk is done, so a
+ * loop costs a wake-up and a hand-off instead of creating and joining threads. Publishing a loop does not
+ * allocate: the body stays on the caller's stack and the workers call it through a function pointer.
+ *
+ * One pool runs one loop at a time: parallelFor() must not be called concurrently, nor from inside a
+ * body. Engines own their pool for that reason.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Starts threads - 1 parked workers (the caller of parallelFor() is the last one).
+     *
+     * @param threads Number of workers (0 = one per hardware thread).
+     */
+    explicit ThreadPool(unsigned threads = 0) : workerCount(resolveThreadCount(threads))
+    {
+        helpers.reserve(workerCount - 1);
+        for (unsigned worker = 1; worker < workerCount; ++worker)
+        {
+            helpers.emplace_back([this, worker] { park(worker); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &thread : helpers)
+        {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Number of workers, the calling thread included.
+     */
+    unsigned threadCount() const { return workerCount; }
+
+    /**
+     * @brief Runs body over [0, count) in chunks of grain items, like the free parallelFor().
+     *
+     * Only as many workers as there are chunks take part; a single chunk runs on the calling thread
+     * without waking anyone.
+     *
+     * @param count Number of items.
+     * @param grain Items per chunk.
+     * @param body Callable as body(unsigned worker, std::size_t begin, std::size_t end), with
+     *             worker < threadCount().
+     */
+    template <typename Body>
+    void parallelFor(std::size_t count, std::size_t grain, Body body)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+        std::size_t chunks = (count + grain - 1) / grain;
+        unsigned workers = static_cast<unsigned>(std::min<std::size_t>(workerCount, chunks));
+        if (workers <= 1)
+        {
+            if (count > 0)
+            {
+                body(0u, std::size_t(0), count);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = {count, grain, &body, &call<Body>};
+            next.store(0, std::memory_order_relaxed);
+            joining = workers - 1;
+            running = workers - 1;
+            round++;
+        }
+        wake.notify_all();
+        work(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return running == 0; });
+    }
+
+private:
+    /**
+     * @brief The loop being run, with its body type erased.
+     */
+    struct Job
+    {
+        std::size_t count = 0;                                                ///< Number of items.
+        std::size_t grain = 1;                                                ///< Items per chunk.
+        void *body = nullptr;                                                 ///< The caller's callable.
+        void (*invoke)(void *, unsigned, std::size_t, std::size_t) = nullptr; ///< Calls body.
+    };
+
+    unsigned workerCount;              ///< Workers, the calling thread included.
+    std::vector<std::thread> helpers;  ///< Parked threads (workers 1 to workerCount - 1).
+    std::mutex mutex;                  ///< Guards everything below except next.
+    std::condition_variable wake;      ///< Signals a new round (or shutdown) to the helpers.
+    std::condition_variable finished;  ///< Signals the caller that the last helper is done.
+    Job job;                           ///< Loop of the current round.
+    std::atomic<std::size_t> next{0};  ///< First item of the next chunk to hand out.
+    std::uint64_t round = 0;           ///< Loops published so far.
+    unsigned joining = 0;              ///< Helpers taking part in the current round.
+    unsigned running = 0;              ///< Of those, helpers not done yet.
+    bool stopping = false;             ///< Set by the destructor.
+
+    template <typename Body>
+    static void call(void *body, unsigned worker, std::size_t begin, std::size_t end)
+    {
+        (*static_cast<Body *>(body))(worker, begin, end);
+    }
+
+    /**
+     * @brief Takes chunks of the current loop until none is left.
+     */
+    void work(unsigned worker)
+    {
+        while (true)
+        {
+            std::size_t begin = next.fetch_add(job.grain, std::memory_order_relaxed);
+            if (begin >= job.count)
+            {
+                break;
+            }
+            job.invoke(job.body, worker, begin, std::min(begin + job.grain, job.count));
+        }
+    }
+
+    /**
+     * @brief Main loop of a helper thread: wait for a round, join it if needed, report back.
+     *
+     * A helper that takes part in a round is counted in running, so the round (and the next one) cannot
+     * start before it has woken up; helpers left out of a round only note that they saw it.
+     */
+    void park(unsigned worker)
+    {
+        std::uint64_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || round != seen; });
+                if (stopping)
+                {
+                    return;
+                }
+                seen = round;
+                if (worker > joining)
+                {
+                    continue;
+                }
+            }
+            work(worker);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0)
+            {
+                finished.notify_one();
+            }
+        }
+    }
+};
+
+#endif // PARALLEL_HPP_
@@ -0,0 +1,420 @@
+#ifndef PATH_CACHE_HPP_
+#define PATH_CACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "batch_query.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "query_context.hpp"
+
+/**
+ * @brief Size limits and policy of a PathCache.
+ */
+struct PathCacheOptions
+{
+    std::size_t pathBytes = 64u << 20;      ///< Budget for (source, target) entries.
+    std::size_t treeBytes = 256u << 20;     ///< Budget for whole shortest-path trees of hot sources.
+    std::uint32_t hotSourceThreshold = 8;   ///< Misses from one source before its whole tree is kept.
+    unsigned shards = 16;                   ///< Independently locked parts of the pair cache.
+};
+
+/**
+ * @brief Hit, miss and eviction counts of a PathCache since it was created.
+ */
+struct PathCacheStats
+{
+    std::uint64_t hits = 0;          ///< Lookups answered from a pair entry or a tree.
+    std::uint64_t treeHits = 0;      ///< Part of hits answered from a tree.
+    std::uint64_t misses = 0;        ///< Lookups that found nothing usable.
+    std::uint64_t evictions = 0;     ///< Entries and trees dropped to stay within budget.
+    std::uint64_t invalidations = 0; ///< Entries and trees dropped because the graph version changed.
+    std::size_t bytes = 0;           ///< Approximate memory held now.
+};
+
+/**
+ * @brief Thread-safe, memory-bounded cache of shortest-path answers.
+ *
+ * Two levels:
+ *  - (source, target) entries with distance and path, in shards that each hold a mutex, an LRU list and
+ *    an equal share of pathBytes, so threads asking different pairs rarely wait for each other;
+ *  - whole trees (distance and predecessor of every node) for sources that missed hotSourceThreshold
+ *    times; one tree answers every target of its source. Trees are read under a shared lock and evicted
+ *    least recently used first.
+ *
+ * Every call carries the graph version the caller works with (CsrGraph::version,
+ * DynamicShortestPaths::version()). Results stored for another version are never returned: the first
+ * call that brings a newer version to a shard (or to the tree store) drops everything it held.
+ *
+ * Sizes are estimates (payload plus a fixed overhead per entry), good enough to bound memory.
+ */
+class PathCache
+{
+public:
+    explicit PathCache(const PathCacheOptions &opts = PathCacheOptions())
+        : options(opts), shards(opts.shards == 0 ? 1 : opts.shards)
+    {
+    }
+
+    /**
+     * @brief Looks up source -> target for the given graph version.
+     *
+     * @param result Receives distance and path on a hit (settled is 0: nothing was searched).
+     * @return true on a hit.
+     */
+    bool lookup(std::uint32_t source, std::uint32_t target, std::uint64_t version, QueryResult &result)
+    {
+        if (lookupTree(source, target, version, result))
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            treeHits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        std::uint64_t key = keyOf(source, target);
+        Shard &shard = shardOf(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            refresh(shard, version);
+            // An older version than the shard's must not see answers computed on the newer graph.
+            auto found = version == shard.version ? shard.index.find(key) : shard.index.end();
+            if (found != shard.index.end())
+            {
+                shard.order.splice(shard.order.begin(), shard.order, found->second);
+                result.distance = found->second->distance;
+                result.settled = 0;
+                result.path = found->second->path;
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        countMiss(source, version);
+        return false;
+    }
+
+    /**
+     * @brief Tells whether source is hot enough that the caller should compute and store its whole tree.
+     */
+    bool wantsTree(std::uint32_t source, std::uint64_t version)
+    {
+        std::lock_guard<std::mutex> lock(missMutex);
+        if (missVersion != version)
+        {
+            return false;
+        }
+        auto found = sourceMisses.find(source);
+        return found != sourceMisses.end() && found->second >= options.hotSourceThreshold;
+    }
+
+    /**
+     * @brief Stores the answer for source -> target computed on the given graph version.
+     */
+    void storePath(std::uint32_t source, std::uint32_t target, std::uint64_t version, const QueryResult &result)
+    {
+        std::uint64_t key = keyOf(source, target);
+        Shard &shard = shardOf(key);
+        std::size_t budget = options.pathBytes / shards.size();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        refresh(shard, version);
+        if (version != shard.version)
+        {
+            return; // Computed on an older graph.
+        }
+        auto found = shard.index.find(key);
+        if (found != shard.index.end())
+        {
+            shard.bytes -= found->second->bytes();
+            shard.order.erase(found->second);
+            shard.index.erase(found);
+        }
+        PairEntry entry{key, result.distance, result.path};
+        if (entry.bytes() > budget)
+        {
+            return;
+        }
+        shard.bytes += entry.bytes();
+        shard.order.push_front(std::move(entry));
+        shard.index[key] = shard.order.begin();
+        while (shard.bytes > budget)
+        {
+            PairEntry &last = shard.order.back();
+            shard.bytes -= last.bytes();
+            shard.index.erase(last.key);
+            shard.order.pop_back();
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Stores the full tree of a finished single-source search (e.g. CsrDijkstra::run(source)).
+     */
+    void storeTree(std::uint32_t source, std::uint64_t version, const QueryContext &tree)
+    {
+        auto stored = std::make_shared<Tree>();
+        std::uint32_t nodeCount = tree.nodeCount();
+        stored->distances.resize(nodeCount);
+        stored->predecessors.resize(nodeCount);
+        for (std::uint32_t node = 0; node < nodeCount; ++node)
+        {
+            stored->distances[node] = tree.distance(node);
+            stored->predecessors[node] = tree.predecessor(node);
+        }
+        stored->source = source;
+        stored->lastUse.store(clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        {
+            // The source has to turn hot again before another tree is built for it, so trees that keep
+            // getting evicted cannot turn every miss into a full search.
+            std::lock_guard<std::mutex> lock(missMutex);
+            sourceMisses.erase(source);
+        }
+        if (stored->bytes() > options.treeBytes)
+        {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(treeMutex);
+        if (version < treeVersion)
+        {
+            return;
+        }
+        if (version != treeVersion)
+        {
+            invalidations.fetch_add(trees.size(), std::memory_order_relaxed);
+            trees.clear();
+            treeBytesUsed = 0;
+            treeVersion = version;
+        }
+        auto found = trees.find(source);
+        if (found != trees.end())
+        {
+            treeBytesUsed -= bytesOf(found->second);
+            trees.erase(found);
+        }
+        const std::size_t storedBytes = stored->bytes();
+        while (treeBytesUsed + storedBytes > options.treeBytes && !trees.empty())
+        {
+            // Least recently used tree, remembered by key and size so nothing is dereferenced after the scan.
+            std::uint32_t oldest = NO_NODE;
+            std::uint64_t oldestUse = std::numeric_limits<std::uint64_t>::max();
+            std::size_t oldestBytes = 0;
+            for (const auto &entry : trees)
+            {
+                const Tree *candidate = entry.second.get();
+                std::uint64_t use = candidate == nullptr ? 0 : candidate->lastUse.load(std::memory_order_relaxed);
+                if (oldest == NO_NODE || use < oldestUse)
+                {
+                    oldest = entry.first;
+                    oldestUse = use;
+                    oldestBytes = candidate == nullptr ? 0 : candidate->bytes();
+                }
+            }
+            treeBytesUsed -= oldestBytes;
+            trees.erase(oldest);
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        treeBytesUsed += storedBytes;
+        trees[source] = std::move(stored);
+    }
+
+    /**
+     * @brief Snapshot of the counters and of the memory in use.
+     */
+    PathCacheStats stats() const
+    {
+        PathCacheStats result;
+        result.hits = hits.load(std::memory_order_relaxed);
+        result.treeHits = treeHits.load(std::memory_order_relaxed);
+        result.misses = misses.load(std::memory_order_relaxed);
+        result.evictions = evictions.load(std::memory_order_relaxed);
+        result.invalidations = invalidations.load(std::memory_order_relaxed);
+        for (const Shard &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            result.bytes += shard.bytes;
+        }
+        std::shared_lock<std::shared_mutex> lock(treeMutex);
+        result.bytes += treeBytesUsed;
+        return result;
+    }
+
+private:
+    static constexpr std::size_t ENTRY_OVERHEAD = 96; ///< List node, hash node and bucket, roughly.
+
+    struct PairEntry
+    {
+        std::uint64_t key;
+        float distance;
+        std::vector<std::uint32_t> path;
+
+        std::size_t bytes() const { return ENTRY_OVERHEAD + path.capacity() * sizeof(std::uint32_t); }
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::list<PairEntry> order; ///< Most recently used first.
+        std::unordered_map<std::uint64_t, std::list<PairEntry>::iterator> index;
+        std::size_t bytes = 0;
+        std::uint64_t version = 0;
+    };
+
+    struct Tree
+    {
+        std::uint32_t source = NO_NODE;
+        std::vector<float> distances;
+        std::vector<std::uint32_t> predecessors;
+        std::atomic<std::uint64_t> lastUse{0}; ///< Tick of the last lookup, for LRU eviction.
+
+        std::size_t bytes() const
+        {
+            return ENTRY_OVERHEAD + distances.size() * (sizeof(float) + sizeof(std::uint32_t));
+        }
+    };
+
+    /**
+     * @brief Memory charged for a stored tree (0 for an empty slot).
+     */
+    static std::size_t bytesOf(const std::shared_ptr<Tree> &tree) { return tree ? tree->bytes() : 0; }
+
+    PathCacheOptions options;
+    std::vector<Shard> shards;
+
+    mutable std::shared_mutex treeMutex;
+    std::unordered_map<std::uint32_t, std::shared_ptr<Tree>> trees;
+    std::size_t treeBytesUsed = 0;
+    std::uint64_t treeVersion = 0;
+
+    std::mutex missMutex;
+    std::unordered_map<std::uint32_t, std::uint32_t> sourceMisses; ///< Misses per source (this version).
+    std::uint64_t missVersion = 0;
+
+    std::atomic<std::uint64_t> clock{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> treeHits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::uint64_t> invalidations{0};
+
+    static std::uint64_t keyOf(std::uint32_t source, std::uint32_t target)
+    {
+        return (std::uint64_t(source) << 32) | target;
+    }
+
+    Shard &shardOf(std::uint64_t key)
+    {
+        return shards[(key * 0x9E3779B97F4A7C15ull >> 32) % shards.size()];
+    }
+
+    /**
+     * @brief Empties a shard that still holds results of an older graph version. Caller holds its lock.
+     */
+    void refresh(Shard &shard, std::uint64_t version)
+    {
+        if (version <= shard.version)
+        {
+            return;
+        }
+        invalidations.fetch_add(shard.order.size(), std::memory_order_relaxed);
+        shard.order.clear();
+        shard.index.clear();
+        shard.bytes = 0;
+        shard.version = version;
+    }
+
+    bool lookupTree(std::uint32_t source, std::uint32_t target, std::uint64_t version, QueryResult &result)
+    {
+        std::shared_ptr<Tree> tree;
+        {
+            std::shared_lock<std::shared_mutex> lock(treeMutex);
+            if (version != treeVersion)
+            {
+                return false;
+            }
+            auto found = trees.find(source);
+            if (found == trees.end())
+            {
+                return false;
+            }
+            tree = found->second;
+        }
+        // The tree is immutable and kept alive by the shared pointer, so the walk needs no lock.
+        tree->lastUse.store(clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        result.distance = tree->distances[target];
+        result.settled = 0;
+        result.path.clear();
+        if (result.distance != INFINITY_VALUE)
+        {
+            for (std::uint32_t node = target; node != NO_NODE; node = tree->predecessors[node])
+            {
+                result.path.push_back(node);
+            }
+            std::reverse(result.path.begin(), result.path.end());
+        }
+        return true;
+    }
+
+    void countMiss(std::uint32_t source, std::uint64_t version)
+    {
+        std::lock_guard<std::mutex> lock(missMutex);
+        if (version != missVersion)
+        {
+            if (version < missVersion)
+            {
+                return;
+            }
+            sourceMisses.clear();
+            missVersion = version;
+        }
+        if (sourceMisses.size() >= MAX_TRACKED_SOURCES)
+        {
+            sourceMisses.clear(); // Forget cold sources rather than grow without bound.
+        }
+        sourceMisses[source]++;
+    }
+
+    static constexpr std::size_t MAX_TRACKED_SOURCES = 1u << 16;
+};
+
+/**
+ * @brief Answers one query through a cache, running engine only on a miss.
+ *
+ * When the source is hot, the engine computes its full tree, which goes into the cache, so later
+ * queries from that source are answered without any search. engine must belong to the calling thread.
+ */
+template <typename Frontier>
+QueryResult cachedQuery(PathCache &cache, CsrDijkstra<Frontier> &engine, Query query, std::uint64_t version)
+{
+    QueryResult result;
+    if (cache.lookup(query.source, query.target, version, result))
+    {
+        return result;
+    }
+    if (cache.wantsTree(query.source, version))
+    {
+        engine.run(query.source);
+        cache.storeTree(query.source, version, engine.context());
+    }
+    else
+    {
+        engine.run(query.source, query.target);
+    }
+    result.distance = engine.distance(query.target);
+    result.settled = engine.settledCount();
+    result.path = engine.path(query.target);
+    cache.storePath(query.source, query.target, version, result);
+    return result;
+}
+
+#endif // PATH_CACHE_HPP_
@@ -0,0 +1,213 @@
+#ifndef QUERY_CONTEXT_HPP_
+#define QUERY_CONTEXT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief Per-node search state (distance, predecessor, settled flag) that can be reused across queries.
+ *
+ * All arrays are sized once for the whole graph. Instead of rewriting them before every query, each
+ * node carries a stamp with the generation in which it was last written: a node whose stamp is older
+ * than the current generation reads as "unreached, infinite distance". Starting a new query is then a
+ * counter increment, and a query only ever writes the nodes it touches.
+ *
+ * Stamps use two values per generation: generation (reached) and generation + 1 (settled).
+ * The touched list records every node reached by the current query, in the order it was first reached.
+ *
+ * A context made without predecessors (for distance-only searches) does not allocate or write them:
+ * engines call reachDistance() instead of reach(), and predecessor() always answers NO_NODE.
+ */
+class QueryContext
+{
+public:
+    /**
+     * @brief Creates a context for a graph with nodeCount nodes.
+     *
+     * @param trackPredecessors Set to false for distance-only searches: no predecessor array at all.
+     */
+    explicit QueryContext(std::uint32_t nodeCount = 0, bool trackPredecessors = true) : tracking(trackPredecessors)
+    {
+        resize(nodeCount);
+    }
+
+    /**
+     * @brief Resizes the arrays for a graph with nodeCount nodes. This is the only call that allocates.
+     */
+    void resize(std::uint32_t nodeCount)
+    {
+        distances.assign(nodeCount, INFINITY_VALUE);
+        predecessors.assign(tracking ? nodeCount : 0, NO_NODE);
+        stamps.assign(nodeCount, 0);
+        touchedNodes.clear();
+        touchedNodes.reserve(nodeCount);
+        generation = 0;
+        reset();
+    }
+
+    std::uint32_t nodeCount() const { return static_cast<std::uint32_t>(stamps.size()); }
+
+    /**
+     * @brief Tells whether predecessors are recorded (false for distance-only contexts).
+     */
+    bool tracksPredecessors() const { return tracking; }
+
+    /**
+     * @brief Forgets the previous query in O(1) (O(V) once every ~2 billion queries, when stamps wrap).
+     */
+    void reset()
+    {
+        touchedNodes.clear();
+        if (generation >= std::numeric_limits<std::uint32_t>::max() - 3)
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 0;
+        }
+        generation += 2;
+    }
+
+    /**
+     * @brief Tells whether the node got a distance during the current query.
+     */
+    bool reached(std::uint32_t node) const { return stamps[node] >= generation; }
+
+    /**
+     * @brief Tells whether the node's distance is final for the current query.
+     */
+    bool isSettled(std::uint32_t node) const { return stamps[node] == generation + 1; }
+
+    /**
+     * @brief Distance of the node in the current query, or INFINITY_VALUE if it was not reached.
+     */
+    float distance(std::uint32_t node) const { return reached(node) ? distances[node] : INFINITY_VALUE; }
+
+    /**
+     * @brief Previous node on the best known path, or NO_NODE.
+     */
+    std::uint32_t predecessor(std::uint32_t node) const
+    {
+        return tracking && reached(node) ? predecessors[node] : NO_NODE;
+    }
+
+    /**
+     * @brief Records a (better) distance and predecessor for the node.
+     */
+    void reach(std::uint32_t node, float distance, std::uint32_t predecessor)
+    {
+        if (!reached(node))
+        {
+            stamps[node] = generation;
+            touchedNodes.push_back(node);
+        }
+        distances[node] = distance;
+        predecessors[node] = predecessor;
+    }
+
+    /**
+     * @brief Records a (better) distance for the node, without a predecessor (distance-only searches).
+     */
+    void reachDistance(std::uint32_t node, float distance)
+    {
+        if (!reached(node))
+        {
+            stamps[node] = generation;
+            touchedNodes.push_back(node);
+        }
+        distances[node] = distance;
+    }
+
+    /**
+     * @brief Marks a reached node as settled.
+     */
+    void settle(std::uint32_t node) { stamps[node] = generation + 1; }
+
+    /**
+     * @brief Raw arrays for vector kernels that test many nodes at once.
+     *
+     * A node's distance is valid only if its stamp equals currentStamp() (reached); currentStamp() + 1
+     * means settled and anything else unreached, as in reached() and isSettled().
+     */
+    const float *distanceData() const { return distances.data(); }
+    const std::uint32_t *stampData() const { return stamps.data(); }
+    std::uint32_t currentStamp() const { return generation; }
+
+    /**
+     * @brief Nodes reached by the current query, in the order they were first reached.
+     */
+    const std::vector<std::uint32_t> &touched() const { return touchedNodes; }
+
+    /**
+     * @brief Number of nodes on the path ending at target (0 if target was not reached).
+     */
+    std::size_t pathLength(std::uint32_t target) const
+    {
+        if (!tracking || !reached(target))
+        {
+            return 0;
+        }
+        std::size_t length = 0;
+        for (std::uint32_t node = target; node != NO_NODE; node = predecessors[node])
+        {
+            length++;
+        }
+        return length;
+    }
+
+    /**
+     * @brief Writes the path ending at target into out[0, length), source first, without allocating.
+     *
+     * The predecessor chain is walked twice: once to measure it, once to fill the buffer from the back,
+     * so the nodes land in forward order with no reversal and no temporary.
+     *
+     * @param target Last node of the path.
+     * @param out Caller-owned buffer.
+     * @param capacity Slots available in out.
+     * @return The path length (0 if target was not reached). If it exceeds capacity nothing is written:
+     *         call again with a buffer of that size.
+     */
+    std::size_t writePath(std::uint32_t target, std::uint32_t *out, std::size_t capacity) const
+    {
+        std::size_t length = pathLength(target);
+        if (length <= capacity)
+        {
+            fillPath(target, out, length);
+        }
+        return length;
+    }
+
+    /**
+     * @brief Same as writePath() into a reusable vector, resized to the path length. Does not allocate
+     *        once the vector has enough capacity.
+     */
+    void writePath(std::uint32_t target, std::vector<std::uint32_t> &out) const
+    {
+        std::size_t length = pathLength(target);
+        out.resize(length);
+        fillPath(target, out.data(), length);
+    }
+
+protected:
+    std::uint32_t generation = 0; ///< Stamp of the current query (always even; tests move it near the wrap).
+
+private:
+    std::vector<float> distances;            ///< Distance of each node (valid only when stamped).
+    std::vector<std::uint32_t> predecessors; ///< Predecessor of each node (valid only when stamped).
+    std::vector<std::uint32_t> stamps;       ///< Generation in which each node was last written.
+    std::vector<std::uint32_t> touchedNodes; ///< Nodes reached by the current query.
+    bool tracking = true;                    ///< Whether predecessors are recorded.
+
+    void fillPath(std::uint32_t target, std::uint32_t *out, std::size_t length) const
+    {
+        for (std::uint32_t node = target; length > 0; node = predecessors[node])
+        {
+            out[--length] = node;
+        }
+    }
+};
+
+#endif // QUERY_CONTEXT_HPP_
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "synthetic_random.hpp"
+
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+/**
+ * @brief Settings of one load run.
+ */
+struct LoadOptions
+{
+    string socketPath = "/tmp/shortest_path.sock"; ///< Server socket.
+    unsigned connections = 4;                      ///< Concurrent clients.
+    uint64_t requests = 10000;                     ///< Requests over all clients.
+    unsigned window = 16;                          ///< Requests a client keeps in flight (pipelining).
+    uint64_t seed = 7;                             ///< Seed of the random (source, target) pairs.
+};
+
+/**
+ * @brief Opens a client connection, or returns -1.
+ */
+static int connectTo(const string &path)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const string &data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t written = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (written <= 0)
+        {
+            return false;
+        }
+        done += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Asks the server for its node count with the "info" request; 0 on failure.
+ */
+static uint32_t queryNodeCount(const string &path)
+{
+    int fd = connectTo(path);
+    if (fd < 0 || !sendAll(fd, "info\n"))
+    {
+        return 0;
+    }
+    char reply[128] = {};
+    size_t filled = 0;
+    while (filled + 1 < sizeof(reply) && memchr(reply, '\n', filled) == nullptr)
+    {
+        ssize_t got = recv(fd, reply + filled, sizeof(reply) - 1 - filled, 0);
+        if (got <= 0)
+        {
+            break;
+        }
+        filled += static_cast<size_t>(got);
+    }
+    close(fd);
+    unsigned long nodes = 0;
+    return sscanf(reply, "nodes %lu", &nodes) == 1 ? static_cast<uint32_t>(nodes) : 0;
+}
+
+/**
+ * @brief Result of one client: the latency of each of its requests, and how many failed.
+ */
+struct ClientResult
+{
+    vector<double> latencies; ///< Microseconds from send to answer.
+    uint64_t errors = 0;      ///< "error" or missing answers.
+};
+
+/**
+ * @brief One client: keeps up to window requests in flight and times every answer.
+ */
+static void runClient(const LoadOptions &options, uint32_t nodeCount, uint64_t requests, uint64_t seed,
+                      ClientResult &result)
+{
+    int fd = connectTo(options.socketPath);
+    if (fd < 0)
+    {
+        result.errors = requests;
+        return;
+    }
+    SyntheticRandom random(seed);
+    vector<Clock::time_point> sentAt(requests);
+    result.latencies.reserve(requests);
+    uint64_t sent = 0;
+    uint64_t answered = 0;
+    string batch;
+    string input;
+    char chunk[64 * 1024];
+    while (answered < requests)
+    {
+        // Top the window up with one write.
+        batch.clear();
+        Clock::time_point now = Clock::now();
+        while (sent < requests && sent - answered < options.window)
+        {
+            batch += to_string(random.below(nodeCount));
+            batch += ' ';
+            batch += to_string(random.below(nodeCount));
+            batch += '\n';
+            sentAt[sent++] = now;
+        }
+        if (!batch.empty() && !sendAll(fd, batch))
+        {
+            break;
+        }
+        ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+        if (got <= 0)
+        {
+            break;
+        }
+        now = Clock::now();
+        input.append(chunk, static_cast<size_t>(got));
+        size_t start = 0;
+        for (size_t newline; (newline = input.find('\n', start)) != string::npos; start = newline + 1)
+        {
+            if (input.compare(start, 5, "error") == 0)
+            {
+                result.errors++;
+            }
+            result.latencies.push_back(chrono::duration<double, micro>(now - sentAt[answered]).count());
+            answered++;
+        }
+        input.erase(0, start);
+    }
+    result.errors += requests - answered;
+    close(fd);
+}
+
+static double percentile(const vector<double> &sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+static void usage()
+{
+    cerr << "usage: query_load [--socket <path>] [--connections <n>] [--requests <n>] [--window <n>]\n"
+            "                  [--seed <n>]\n"
+            "\n"
+            "Sends random \"<source> <target>\" queries to a running query_server and reports\n"
+            "throughput and latency percentiles.\n";
+}
+
+/**
+ * @brief Load generator for query_server: throughput and latency percentiles under pipelined load.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread query_load.cpp -o query_load
+ *
+ * @return int Exit status (1 if any request failed).
+ */
+int main(int argc, char **argv)
+{
+    LoadOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            usage();
+            return 2;
+        }
+        const char *value = argv[++i];
+        if (arg == "--socket")
+        {
+            options.socketPath = value;
+        }
+        else if (arg == "--connections")
+        {
+            options.connections = max(1u, static_cast<unsigned>(strtoul(value, nullptr, 10)));
+        }
+        else if (arg == "--requests")
+        {
+            options.requests = strtoull(value, nullptr, 10);
+        }
+        else if (arg == "--window")
+        {
+            options.window = max(1u, static_cast<unsigned>(strtoul(value, nullptr, 10)));
+        }
+        else if (arg == "--seed")
+        {
+            options.seed = strtoull(value, nullptr, 10);
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    uint32_t nodeCount = queryNodeCount(options.socketPath);
+    if (nodeCount == 0)
+    {
+        cerr << "no server answering on " << options.socketPath << '\n';
+        return 1;
+    }
+
+    vector<ClientResult> results(options.connections);
+    vector<thread> clients;
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < options.connections; ++i)
+    {
+        uint64_t share = options.requests / options.connections + (i < options.requests % options.connections);
+        clients.emplace_back(runClient, cref(options), nodeCount, share, options.seed + i, ref(results[i]));
+    }
+    for (thread &client : clients)
+    {
+        client.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> latencies;
+    uint64_t errors = 0;
+    for (const ClientResult &result : results)
+    {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+    }
+    sort(latencies.begin(), latencies.end());
+    printf("%llu requests, %u connections, window %u, %llu errors\n",
+           static_cast<unsigned long long>(options.requests), options.connections, options.window,
+           static_cast<unsigned long long>(errors));
+    printf("throughput: %.0f requests/s over %.2f s\n", static_cast<double>(latencies.size()) / seconds, seconds);
+    printf("latency (us): p50 %.0f  p90 %.0f  p99 %.0f  p99.9 %.0f  max %.0f\n", percentile(latencies, 0.50),
+           percentile(latencies, 0.90), percentile(latencies, 0.99), percentile(latencies, 0.999),
+           latencies.empty() ? 0.0 : latencies.back());
+    return errors == 0 ? 0 : 1;
+}
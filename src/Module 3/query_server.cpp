@@ -0,0 +1,180 @@
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "edge_list_parser.hpp"
+#include "graph_file.hpp"
+#include "query_server.hpp"
+#include "synthetic_graphs.hpp"
+
+using namespace std;
+
+/**
+ * @brief Server instance the signal handlers stop.
+ */
+static QueryServer *activeServer = nullptr;
+
+static void stopServer(int)
+{
+    if (activeServer != nullptr)
+    {
+        activeServer->stop();
+    }
+}
+
+static void usage()
+{
+    cerr << "usage: query_server (<graph file> | --road <nodes>) [--socket <path> | --stdin]\n"
+            "                    [--threads <n>] [--no-paths] [--max-batch <n>]\n"
+            "\n"
+            "Loads the graph once and answers \"<source> <target>\" lines (see query_server.hpp).\n"
+            "A graph file is either a binary graph file (mapped in place, checked once at startup) or a\n"
+            "from,to,weight edge list.\n"
+            "--road builds a synthetic road-like graph instead, for load tests.\n";
+}
+
+/**
+ * @brief Tells whether a file starts with the binary graph file magic.
+ */
+static bool isBinaryGraphFile(const string &path)
+{
+    char magic[sizeof(GRAPH_FILE_MAGIC)] = {};
+    ifstream in(path, ios::binary);
+    return in.read(magic, sizeof(magic)) && memcmp(magic, GRAPH_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Query server: loads a graph once, then answers shortest-path queries over a Unix socket or stdin.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread query_server.cpp -o query_server
+ * Try:   ./query_server --road 100000 --socket /tmp/sp.sock &
+ *        ./query_load --socket /tmp/sp.sock --requests 100000
+ *        echo "0 99" | ./query_server --road 1000 --stdin
+ *
+ * @return int Exit status.
+ */
+int main(int argc, char **argv)
+{
+    string graphPath;
+    string socketPath = "/tmp/shortest_path.sock";
+    uint32_t roadNodes = 0;
+    bool useStdin = false;
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue)
+        {
+            socketPath = argv[++i];
+        }
+        else if (arg == "--stdin")
+        {
+            useStdin = true;
+        }
+        else if (arg == "--road" && hasValue)
+        {
+            roadNodes = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--threads" && hasValue)
+        {
+            options.threads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--max-batch" && hasValue)
+        {
+            options.maxBatch = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--no-paths")
+        {
+            options.withPaths = false;
+        }
+        else if (!arg.empty() && arg[0] != '-' && graphPath.empty())
+        {
+            graphPath = arg;
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+    if (graphPath.empty() == (roadNodes == 0))
+    {
+        usage();
+        return 2;
+    }
+
+    // Load the graph once; the server only keeps a view of it.
+    CsrGraph owned;
+    unique_ptr<MappedGraph> mapped;
+    CsrView graph;
+    try
+    {
+        if (roadNodes != 0)
+        {
+            owned = makeRoadGraph(roadNodes, 1);
+            graph = owned.view();
+        }
+        else if (isBinaryGraphFile(graphPath))
+        {
+            // The engines index the mapped arrays without bounds checks: never serve a file that has not
+            // been checked once. Both checks read the whole file, which a server does only at startup.
+            mapped.reset(new MappedGraph(graphPath));
+            if (!mapped->verifyChecksum())
+            {
+                throw runtime_error("checksum mismatch, the graph file is damaged: " + graphPath);
+            }
+            if (!mapped->validate())
+            {
+                throw runtime_error("inconsistent CSR arrays in graph file: " + graphPath);
+            }
+            graph = mapped->view();
+        }
+        else
+        {
+            owned = loadEdgeList(graphPath);
+            graph = owned.view();
+        }
+    }
+    catch (const exception &error)
+    {
+        cerr << error.what() << '\n';
+        return 1;
+    }
+    cerr << "graph: " << graph.nodeCount << " nodes, " << graph.edgeCount << " edges\n";
+
+    QueryServer server(graph, options);
+    if (useStdin)
+    {
+        signal(SIGPIPE, SIG_IGN);
+        server.servePipe(0, 1);
+        return 0;
+    }
+
+    activeServer = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    signal(SIGPIPE, SIG_IGN);
+    cerr << "listening on " << socketPath << '\n';
+    try
+    {
+        server.serveSocket(socketPath);
+    }
+    catch (const exception &error)
+    {
+        cerr << error.what() << '\n';
+        return 1;
+    }
+    activeServer = nullptr;
+
+    const ServerStats &stats = server.stats();
+    cerr << stats.requests << " requests in " << stats.batches << " batches (largest " << stats.largestBatch
+         << ") from " << stats.connections << " connections\n";
+    return 0;
+}
@@ -0,0 +1,608 @@
+#ifndef QUERY_SERVER_HPP_
+#define QUERY_SERVER_HPP_
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "batch_query.hpp"
+#include "csr_graph.hpp"
+
+/**
+ * @brief Settings of a QueryServer.
+ */
+struct ServerOptions
+{
+    unsigned threads = 0;             ///< Worker threads answering a batch (0 = one per hardware thread).
+    bool withPaths = true;            ///< Send the node list with every answer.
+    std::size_t maxBatch = 4096;      ///< Queries answered at once; a larger burst is split.
+    std::size_t maxLine = 256;        ///< Longest accepted request line; a client sending more is dropped.
+    std::size_t maxOutput = 1u << 20; ///< Unsent answer bytes above which a client's requests are not read.
+};
+
+/**
+ * @brief Counters of a QueryServer since it started.
+ */
+struct ServerStats
+{
+    std::uint64_t requests = 0;     ///< Query lines answered (including errors).
+    std::uint64_t batches = 0;      ///< Batches handed to the workers.
+    std::uint64_t largestBatch = 0; ///< Most queries in one batch.
+    std::uint64_t connections = 0;  ///< Clients accepted.
+};
+
+/**
+ * @brief Long-running shortest-path server: the graph is loaded once, queries arrive as text lines.
+ *
+ * Protocol, one request per line, answers in request order on the same connection (clients may pipeline):
+ *
+ *     <source> <target>     ->  <distance> <count> <node> ... <node>   (path source first)
+ *                           ->  <distance>                             (server started without paths)
+ *                           ->  unreachable
+ *     info                  ->  nodes <nodeCount> edges <edgeCount>
+ *     anything else         ->  error <reason>
+ *
+ * serveSocket() runs an epoll event loop over a Unix domain socket. Each round it reads everything that
+ * is ready on every connection, so requests that arrived together (from one client or many) form one
+ * batch. The batch is answered by a BatchQueryEngine, whose per-thread engines keep their scratch arrays
+ * and whose threads stay parked between batches, and the answers are queued on each connection and
+ * written without blocking. Requests that arrive while a batch is being answered wait in the socket
+ * buffers and make up the next batch, so batches grow with the load instead of queries queueing one by one.
+ * A client that pipelines requests faster than it reads the answers is not read from while more than
+ * maxOutput bytes of answers wait for it, and its writes block instead. Requests already read are still
+ * answered, so the answers queued for one client stay below maxOutput plus one batch (maxBatch answers).
+ *
+ * servePipe() answers the same protocol from a file descriptor pair (stdin and stdout), batching
+ * whatever each read() returns.
+ */
+class QueryServer
+{
+public:
+    /**
+     * @brief Creates the server and its worker engines. The graph must outlive the server.
+     */
+    explicit QueryServer(CsrView g, const ServerOptions &opts = ServerOptions())
+        : graph(g), options(opts), engine(g, opts.threads)
+    {
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0)
+        {
+            throw std::runtime_error("cannot create eventfd");
+        }
+    }
+
+    QueryServer(const QueryServer &) = delete;
+    QueryServer &operator=(const QueryServer &) = delete;
+
+    ~QueryServer() { ::close(wakeFd); }
+
+    /**
+     * @brief Makes serveSocket() return after the current round. Async-signal-safe (one write()).
+     */
+    void stop()
+    {
+        std::uint64_t one = 1;
+        ssize_t written = ::write(wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+
+    const ServerStats &stats() const { return counters; }
+
+    /**
+     * @brief Listens on a Unix domain socket and answers clients until stop() is called.
+     *
+     * An existing socket file at path is replaced, and removed again on return.
+     *
+     * @throws std::runtime_error if the socket cannot be set up.
+     */
+    void serveSocket(const std::string &path)
+    {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            throw std::runtime_error("socket path too long: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0)
+        {
+            throw std::runtime_error("cannot create socket");
+        }
+        ::unlink(path.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            ::listen(listener, SOMAXCONN) != 0)
+        {
+            ::close(listener);
+            throw std::runtime_error("cannot listen on " + path);
+        }
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0)
+        {
+            ::close(listener);
+            throw std::runtime_error("cannot create epoll instance");
+        }
+        watch(listener, EPOLLIN, EPOLL_CTL_ADD);
+        watch(wakeFd, EPOLLIN, EPOLL_CTL_ADD);
+
+        std::vector<epoll_event> events(256);
+        bool running = true;
+        while (running)
+        {
+            int ready = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            for (std::size_t i = 0; i < static_cast<std::size_t>(ready); ++i)
+            {
+                const epoll_event &event = events[i];
+                int fd = event.data.fd;
+                if (fd == wakeFd)
+                {
+                    running = false;
+                }
+                else if (fd == listener)
+                {
+                    acceptAll(listener);
+                }
+                else
+                {
+                    auto found = connections.find(fd);
+                    if (found == connections.end())
+                    {
+                        continue;
+                    }
+                    Connection &connection = *found->second;
+                    if (event.events & EPOLLOUT)
+                    {
+                        flush(connection);
+                    }
+                    if (event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                    {
+                        readAll(connection);
+                        updateInterest(connection);
+                    }
+                }
+            }
+            answerBatch();
+            closeFinished();
+        }
+
+        for (auto &entry : connections)
+        {
+            ::close(entry.first);
+        }
+        connections.clear();
+        ::close(epollFd);
+        epollFd = -1;
+        ::close(listener);
+        ::unlink(path.c_str());
+    }
+
+    /**
+     * @brief Answers requests read from input on output until input reaches end of file.
+     */
+    void servePipe(int input, int output)
+    {
+        Connection connection;
+        connection.inFd = input;
+        connection.outFd = output;
+        connection.isSocket = false;
+        char chunk[READ_CHUNK];
+        while (true)
+        {
+            ssize_t got = ::read(input, chunk, sizeof(chunk));
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got <= 0)
+            {
+                break;
+            }
+            consume(connection, chunk, static_cast<std::size_t>(got));
+            answerBatch();
+            if (!writeBlocking(connection) || connection.closing)
+            {
+                return;
+            }
+        }
+        if (!connection.input.empty())
+        {
+            // Last line without a newline.
+            consume(connection, "\n", 1);
+            answerBatch();
+            writeBlocking(connection);
+        }
+    }
+
+private:
+    static constexpr std::size_t READ_CHUNK = 64 * 1024;
+
+    /**
+     * @brief One client: its unparsed input and its queued answers.
+     */
+    struct Connection
+    {
+        int inFd = -1;            ///< Read side (the socket, or stdin).
+        int outFd = -1;           ///< Write side (the socket, or stdout).
+        bool isSocket = true;     ///< Use send() (no SIGPIPE) and epoll for writes.
+        std::string input;        ///< Bytes received after the last complete line.
+        std::string output;       ///< Answers not yet written.
+        std::size_t sent = 0;     ///< Bytes of output already written.
+        std::uint32_t interest = EPOLLIN | EPOLLRDHUP; ///< Events the socket is registered for.
+        bool peerDone = false;    ///< End of input reached.
+        bool closing = false;     ///< Drop once the output is written (or at once on error).
+        bool broken = false;      ///< I/O error: drop without writing.
+    };
+
+    /**
+     * @brief A request of the current batch: where to answer, and which query (or none, for an error).
+     */
+    struct Pending
+    {
+        Connection *connection;  ///< Client that sent it.
+        std::uint32_t query;     ///< Index in batchQueries, or NO_NODE for an info or error line.
+        const char *reply;       ///< Error text (or nullptr) when query is NO_NODE.
+    };
+
+    CsrView graph;                         ///< Graph served.
+    ServerOptions options;                 ///< Settings.
+    BatchQueryEngine<> engine;             ///< Per-thread search engines.
+    ServerStats counters;                  ///< Totals.
+    int wakeFd = -1;                       ///< eventfd written by stop().
+    int epollFd = -1;                      ///< Event loop of serveSocket().
+    std::unordered_map<int, std::unique_ptr<Connection>> connections; ///< Open clients by socket.
+    std::vector<Query> batchQueries;       ///< Queries of the current batch.
+    std::vector<Pending> pending;          ///< Every request line of the current batch, in arrival order.
+    std::vector<QueryResult> results;      ///< Answers to batchQueries (path buffers reused).
+    std::vector<Connection *> touched;     ///< Connections with new output after a batch.
+
+    void watch(int fd, std::uint32_t events, int operation)
+    {
+        epoll_event event = {};
+        event.events = events;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, operation, fd, &event);
+    }
+
+    void acceptAll(int listener)
+    {
+        while (true)
+        {
+            int client = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (client < 0)
+            {
+                return; // EAGAIN: no more pending connections (or a transient error).
+            }
+            auto connection = std::make_unique<Connection>();
+            connection->inFd = client;
+            connection->outFd = client;
+            connections.emplace(client, std::move(connection));
+            watch(client, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+            counters.connections++;
+        }
+    }
+
+    /**
+     * @brief Reads everything available on a socket and queues its complete lines.
+     */
+    void readAll(Connection &connection)
+    {
+        char chunk[READ_CHUNK];
+        while (!connection.peerDone && !connection.closing && !outputFull(connection))
+        {
+            ssize_t got = ::recv(connection.inFd, chunk, sizeof(chunk), 0);
+            if (got > 0)
+            {
+                consume(connection, chunk, static_cast<std::size_t>(got));
+                continue;
+            }
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got < 0 && wouldBlock(errno))
+            {
+                return;
+            }
+            // End of input (or error): answer what was received, then close.
+            connection.peerDone = true;
+            connection.closing = true;
+            connection.broken = got < 0;
+        }
+    }
+
+    /**
+     * @brief Splits received bytes into lines and turns each line into a pending request.
+     *
+     * A line longer than maxLine, complete or not, gets an error reply and the connection is closed: what
+     * follows it is not parsed.
+     */
+    void consume(Connection &connection, const char *data, std::size_t size)
+    {
+        connection.input.append(data, size);
+        std::size_t start = 0;
+        while (true)
+        {
+            std::size_t newline = connection.input.find('\n', start);
+            std::size_t lineEnd = newline == std::string::npos ? connection.input.size() : newline;
+            if (lineEnd - start > options.maxLine)
+            {
+                pending.push_back({&connection, NO_NODE, "error line too long"});
+                connection.input.clear();
+                connection.closing = true;
+                return;
+            }
+            if (newline == std::string::npos)
+            {
+                break;
+            }
+            parseLine(connection, connection.input.data() + start, connection.input.data() + newline);
+            start = newline + 1;
+            if (batchQueries.size() >= options.maxBatch)
+            {
+                answerBatch();
+            }
+        }
+        connection.input.erase(0, start);
+    }
+
+    void parseLine(Connection &connection, const char *begin, const char *end)
+    {
+        if (end > begin && end[-1] == '\r')
+        {
+            end--;
+        }
+        auto skipSpaces = [&](const char *cursor)
+        {
+            while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+            {
+                cursor++;
+            }
+            return cursor;
+        };
+        const char *cursor = skipSpaces(begin);
+        if (end - cursor == 4 && std::memcmp(cursor, "info", 4) == 0)
+        {
+            pending.push_back({&connection, NO_NODE, nullptr});
+            return;
+        }
+        Query query;
+        auto first = std::from_chars(cursor, end, query.source);
+        auto second = std::from_chars(skipSpaces(first.ptr), end, query.target);
+        if (first.ec != std::errc() || first.ptr == cursor || second.ec != std::errc() ||
+            skipSpaces(second.ptr) != end || first.ptr == skipSpaces(first.ptr))
+        {
+            pending.push_back({&connection, NO_NODE, "error expected: <source> <target>"});
+            return;
+        }
+        if (query.source >= graph.nodeCount || query.target >= graph.nodeCount)
+        {
+            pending.push_back({&connection, NO_NODE, "error node out of range"});
+            return;
+        }
+        pending.push_back({&connection, static_cast<std::uint32_t>(batchQueries.size()), nullptr});
+        batchQueries.push_back(query);
+    }
+
+    /**
+     * @brief Answers every pending request and queues the replies on their connections.
+     */
+    void answerBatch()
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+        if (!batchQueries.empty())
+        {
+            engine.answer(batchQueries, results, options.withPaths);
+            counters.batches++;
+            counters.largestBatch = std::max<std::uint64_t>(counters.largestBatch, batchQueries.size());
+        }
+        char number[32];
+        for (const Pending &request : pending)
+        {
+            std::string &out = request.connection->output;
+            if (request.query != NO_NODE)
+            {
+                const QueryResult &result = results[request.query];
+                if (result.distance == INFINITY_VALUE)
+                {
+                    out += "unreachable";
+                }
+                else
+                {
+                    int length = std::snprintf(number, sizeof(number), "%.9g", static_cast<double>(result.distance));
+                    out.append(number, static_cast<std::size_t>(length));
+                    if (options.withPaths)
+                    {
+                        appendNumber(out, result.path.size());
+                        for (std::uint32_t node : result.path)
+                        {
+                            appendNumber(out, node);
+                        }
+                    }
+                }
+            }
+            else if (request.reply != nullptr)
+            {
+                out += request.reply;
+            }
+            else
+            {
+                out += "nodes ";
+                out += std::to_string(graph.nodeCount);
+                out += " edges ";
+                out += std::to_string(graph.edgeCount);
+            }
+            out += '\n';
+            if (touched.empty() || touched.back() != request.connection)
+            {
+                touched.push_back(request.connection);
+            }
+        }
+        counters.requests += pending.size();
+        pending.clear();
+        batchQueries.clear();
+
+        for (Connection *connection : touched)
+        {
+            if (connection->isSocket)
+            {
+                flush(*connection);
+            }
+        }
+        touched.clear();
+    }
+
+    static void appendNumber(std::string &out, std::size_t value)
+    {
+        char digits[24];
+        digits[0] = ' ';
+        auto written = std::to_chars(digits + 1, digits + sizeof(digits), value);
+        out.append(digits, written.ptr);
+    }
+
+    /**
+     * @brief Writes as much queued output as the socket takes; asks for EPOLLOUT when it is full.
+     */
+    void flush(Connection &connection)
+    {
+        while (connection.sent < connection.output.size() && !connection.broken)
+        {
+            ssize_t written = ::send(connection.outFd, connection.output.data() + connection.sent,
+                                     connection.output.size() - connection.sent, MSG_NOSIGNAL);
+            if (written > 0)
+            {
+                connection.sent += static_cast<std::size_t>(written);
+            }
+            else if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (written < 0 && wouldBlock(errno))
+            {
+                break;
+            }
+            else
+            {
+                connection.broken = true;
+                connection.closing = true;
+            }
+        }
+        if (connection.sent == connection.output.size())
+        {
+            connection.output.clear();
+            connection.sent = 0;
+        }
+        updateInterest(connection);
+    }
+
+    /**
+     * @brief Tells whether errno says a non-blocking call found nothing to do (EAGAIN or EWOULDBLOCK).
+     */
+    static bool wouldBlock(int error)
+    {
+#if EAGAIN == EWOULDBLOCK
+        return error == EAGAIN;
+#else
+        return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+    }
+
+    /**
+     * @brief Tells whether a client has so many unsent answers that its requests should wait.
+     */
+    bool outputFull(const Connection &connection) const
+    {
+        return connection.output.size() - connection.sent >= options.maxOutput;
+    }
+
+    /**
+     * @brief Registers the events a socket needs now: input until it closes (paused while outputFull()),
+     *        output while some is queued.
+     */
+    void updateInterest(Connection &connection)
+    {
+        std::uint32_t wanted = connection.closing || outputFull(connection) ? 0u : EPOLLIN | EPOLLRDHUP;
+        if (!connection.output.empty() && !connection.broken)
+        {
+            wanted |= EPOLLOUT;
+        }
+        if (wanted != connection.interest)
+        {
+            connection.interest = wanted;
+            watch(connection.inFd, wanted, EPOLL_CTL_MOD);
+        }
+    }
+
+    /**
+     * @brief Blocking write of the queued output (pipe mode). Returns false on error.
+     */
+    static bool writeBlocking(Connection &connection)
+    {
+        std::size_t done = 0;
+        while (done < connection.output.size())
+        {
+            ssize_t written = ::write(connection.outFd, connection.output.data() + done,
+                                      connection.output.size() - done);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                return false;
+            }
+            done += static_cast<std::size_t>(written);
+        }
+        connection.output.clear();
+        return true;
+    }
+
+    /**
+     * @brief Drops connections that are closing and have nothing left to write.
+     */
+    void closeFinished()
+    {
+        for (auto it = connections.begin(); it != connections.end();)
+        {
+            Connection &connection = *it->second;
+            if (connection.closing && (connection.output.empty() || connection.broken))
+            {
+                ::epoll_ctl(epollFd, EPOLL_CTL_DEL, it->first, nullptr);
+                ::close(it->first);
+                it = connections.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+};
+
+#endif // QUERY_SERVER_HPP_
@@ -0,0 +1,107 @@
+#ifndef RELAX_KERNELS_HPP_
+#define RELAX_KERNELS_HPP_
+
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "simd.hpp"
+
+/**
+ * @brief Vector filters for edge relaxation over packed CSR rows.
+ *
+ * A kernel takes a block of consecutive edges of one row (targets and weights side by side in the CSR
+ * arrays), gathers the current stamp and distance of every target, and returns a bit mask of the edges
+ * whose candidate distance base + weight beats the target's distance and whose target is not settled.
+ * Bit i stands for edge i of the block.
+ *
+ * The mask is a filter, not the update: the engine re-checks the flagged edges one by one, in order,
+ * with the scalar test. An edge left out can never pass that test (distances only go down while a row is
+ * relaxed), and a flagged edge whose target was already improved by an earlier parallel edge of the same
+ * block is rejected by it, so the engine makes exactly the updates and heap pushes of the scalar loop.
+ *
+ * Gathers index with signed 32-bit lanes, so node ids must stay below 2^31.
+ */
+
+/**
+ * @brief Number of edges one kernel call covers, 0 for SimdLevel::Scalar.
+ */
+inline std::uint32_t relaxBlockWidth(SimdLevel level)
+{
+    if (level == SimdLevel::Avx512)
+    {
+        return 16;
+    }
+    return level == SimdLevel::Avx2 ? 8 : 0;
+}
+
+#if SIMD_X86
+SIMD_TARGET_AVX2 inline std::uint32_t improvingEdgesAvx2(const std::uint32_t *targets, const float *weights,
+                                                         float base, const float *distances,
+                                                         const std::uint32_t *stamps, std::uint32_t stamp)
+{
+    const __m256i nodes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(targets));
+    const __m256 candidate = _mm256_add_ps(_mm256_set1_ps(base), _mm256_loadu_ps(weights));
+    const __m256i nodeStamps = _mm256_i32gather_epi32(reinterpret_cast<const int *>(stamps), nodes, 4);
+    const __m256 nodeDistances = _mm256_i32gather_ps(distances, nodes, 4);
+
+    // Unreached nodes read as infinite; settled ones are never improved.
+    const __m256i reached = _mm256_cmpeq_epi32(nodeStamps, _mm256_set1_epi32(static_cast<int>(stamp)));
+    const __m256i settled = _mm256_cmpeq_epi32(nodeStamps, _mm256_set1_epi32(static_cast<int>(stamp + 1)));
+    const __m256 current =
+        _mm256_blendv_ps(_mm256_set1_ps(INFINITY_VALUE), nodeDistances, _mm256_castsi256_ps(reached));
+    const __m256 better =
+        _mm256_andnot_ps(_mm256_castsi256_ps(settled), _mm256_cmp_ps(candidate, current, _CMP_LT_OQ));
+    return static_cast<std::uint32_t>(_mm256_movemask_ps(better));
+}
+
+SIMD_TARGET_AVX512 inline std::uint32_t improvingEdgesAvx512(const std::uint32_t *targets, const float *weights,
+                                                             float base, const float *distances,
+                                                             const std::uint32_t *stamps, std::uint32_t stamp)
+{
+    const __m512i nodes = _mm512_loadu_si512(targets);
+    const __m512 candidate = _mm512_add_ps(_mm512_set1_ps(base), _mm512_loadu_ps(weights));
+    // Masked gathers with every lane on: the plain ones trip -Wuninitialized in GCC 12's headers. Without
+    // optimization GCC defines these as macros that hand the mask to the builtin as a short, which
+    // -Wsign-conversion flags for 0xFFFF although only the bit pattern matters.
+    const __mmask16 all = 0xFFFF;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+    const __m512i nodeStamps = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), all, nodes, stamps, 4);
+    const __m512 nodeDistances = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), all, nodes, distances, 4);
+#pragma GCC diagnostic pop
+
+    const __mmask16 reached = _mm512_cmpeq_epi32_mask(nodeStamps, _mm512_set1_epi32(static_cast<int>(stamp)));
+    const __mmask16 settled = _mm512_cmpeq_epi32_mask(nodeStamps, _mm512_set1_epi32(static_cast<int>(stamp + 1)));
+    const __m512 current = _mm512_mask_blend_ps(reached, _mm512_set1_ps(INFINITY_VALUE), nodeDistances);
+    return _mm512_mask_cmp_ps_mask(static_cast<__mmask16>(~settled), candidate, current, _CMP_LT_OQ);
+}
+#endif
+
+/**
+ * @brief Mask of the edges of a block that may improve their target (see the top of this file).
+ *
+ * @param level Kernel to run; must not be SimdLevel::Scalar.
+ * @param targets First of relaxBlockWidth(level) head nodes.
+ * @param weights Their edge costs.
+ * @param base Distance of the node being relaxed.
+ * @param distances QueryContext::distanceData().
+ * @param stamps QueryContext::stampData().
+ * @param stamp QueryContext::currentStamp().
+ */
+inline std::uint32_t improvingEdges(SimdLevel level, const std::uint32_t *targets, const float *weights, float base,
+                                    const float *distances, const std::uint32_t *stamps, std::uint32_t stamp)
+{
+#if SIMD_X86
+    if (level == SimdLevel::Avx512)
+    {
+        return improvingEdgesAvx512(targets, weights, base, distances, stamps, stamp);
+    }
+    return improvingEdgesAvx2(targets, weights, base, distances, stamps, stamp);
+#else
+    // No kernels here: flag every edge and let the scalar test decide.
+    (void)targets, (void)weights, (void)base, (void)distances, (void)stamps, (void)stamp;
+    return (1u << relaxBlockWidth(level)) - 1;
+#endif
+}
+
+#endif // RELAX_KERNELS_HPP_
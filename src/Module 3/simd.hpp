@@ -0,0 +1,60 @@
+#ifndef SIMD_HPP_
+#define SIMD_HPP_
+
+/**
+ * @brief Runtime selection of vector instruction sets.
+ *
+ * Vector kernels are compiled with a per-function target attribute instead of a global -mavx2 flag, so
+ * the same binary runs on any x86-64 CPU and picks the widest kernel the machine supports at run time.
+ * On other compilers or architectures only the scalar kernels exist.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define SIMD_X86 0
+#endif
+
+/**
+ * @brief Instruction sets a kernel can be dispatched to, narrowest first.
+ */
+enum class SimdLevel
+{
+    Scalar, ///< Plain C++.
+    Avx2,   ///< 256-bit AVX2 (8 floats per instruction).
+    Avx512  ///< 512-bit AVX-512F (16 floats per instruction).
+};
+
+/**
+ * @brief Widest instruction set supported by the running CPU.
+ */
+inline SimdLevel detectSimdLevel()
+{
+#if SIMD_X86
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::Avx2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+/**
+ * @brief Name of an instruction set, for reports.
+ */
+inline const char *simdLevelName(SimdLevel level)
+{
+    if (level == SimdLevel::Avx512)
+    {
+        return "AVX-512";
+    }
+    return level == SimdLevel::Avx2 ? "AVX2" : "scalar";
+}
+
+#endif // SIMD_HPP_
@@ -0,0 +1,260 @@
+#ifndef STATIC_GRAPH_HPP_
+#define STATIC_GRAPH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief Edge of a fixed graph written with character labels, like the GRAPH literal of the examples.
+ */
+struct StaticEdge
+{
+    char from;    ///< Tail node label.
+    char to;      ///< Head node label.
+    float weight; ///< Travel cost.
+};
+
+/**
+ * @brief CSR graph whose size is fixed at compile time, stored in std::arrays so it can be a constexpr.
+ *
+ * The same layout as CsrGraph (edges of node u in [offsets[u], offsets[u + 1])), so view() hands it to
+ * any CSR engine at runtime. Built with makeStaticGraph().
+ *
+ * @tparam N Number of nodes.
+ * @tparam M Number of edges.
+ */
+template <std::size_t N, std::size_t M>
+struct StaticGraph
+{
+    std::array<std::uint32_t, N + 1> offsets{}; ///< N + 1 row offsets.
+    std::array<std::uint32_t, M> targets{};     ///< M head nodes.
+    std::array<float, M> weights{};             ///< M edge costs.
+    std::array<char, N> labels{};               ///< Character label of every node ('\0' if it has none).
+
+    static constexpr std::uint32_t nodeCount() { return static_cast<std::uint32_t>(N); }
+    static constexpr std::uint32_t edgeCount() { return static_cast<std::uint32_t>(M); }
+
+    /**
+     * @brief Dense id of a character label, or NO_NODE if the graph has no such node.
+     */
+    constexpr std::uint32_t idOf(char label) const
+    {
+        for (std::uint32_t id = 0; id < N; ++id)
+        {
+            if (labels[id] == label)
+            {
+                return id;
+            }
+        }
+        return NO_NODE;
+    }
+
+    /**
+     * @brief Non-owning view for the runtime CSR engines.
+     */
+    constexpr CsrView view() const
+    {
+        CsrView v;
+        v.nodeCount = nodeCount();
+        v.edgeCount = edgeCount();
+        v.offsets = offsets.data();
+        v.targets = targets.data();
+        v.weights = weights.data();
+        return v;
+    }
+};
+
+/**
+ * @brief Builds a fixed graph from dense ids, at compile time when used in a constant expression.
+ *
+ * Edges are bucketed by tail node keeping their input order, as buildCsrGraph() does. An endpoint outside
+ * [0, N) or a negative weight is reported with std::invalid_argument, which makes a constexpr build fail
+ * to compile.
+ *
+ * @tparam N Number of nodes.
+ * @param edges Directed edges.
+ */
+template <std::size_t N, std::size_t M>
+constexpr StaticGraph<N, M> makeStaticGraph(const Edge (&edges)[M])
+{
+    StaticGraph<N, M> g{};
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        if (edges[i].from >= N || edges[i].to >= N)
+        {
+            throw std::invalid_argument("makeStaticGraph: edge endpoint out of range");
+        }
+        if (!(edges[i].weight >= 0.0f))
+        {
+            throw std::invalid_argument("makeStaticGraph: negative edge weight");
+        }
+        g.offsets[edges[i].from + 1]++;
+    }
+    for (std::size_t node = 0; node < N; ++node)
+    {
+        g.offsets[node + 1] += g.offsets[node];
+    }
+    std::array<std::uint32_t, N + 1> cursor = g.offsets;
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        std::uint32_t slot = cursor[edges[i].from]++;
+        g.targets[slot] = edges[i].to;
+        g.weights[slot] = edges[i].weight;
+    }
+    return g;
+}
+
+/**
+ * @brief Builds a fixed graph from labelled edges; node i is labels[i].
+ *
+ *     constexpr auto ROADS = makeStaticGraph("ABC", {{'A', 'B', 4.0f}, {'B', 'C', 1.0f}});
+ *
+ * @param labels One character per node, as a string literal.
+ * @param edges Directed edges between those labels; an unknown label fails like an out-of-range id.
+ */
+template <std::size_t L, std::size_t M>
+constexpr StaticGraph<L - 1, M> makeStaticGraph(const char (&labels)[L], const StaticEdge (&edges)[M])
+{
+    constexpr std::size_t N = L - 1;
+    std::array<char, N> names{};
+    for (std::size_t id = 0; id < N; ++id)
+    {
+        names[id] = labels[id];
+    }
+    Edge numbered[M]{};
+    StaticGraph<N, 0> lookup{};
+    lookup.labels = names;
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        numbered[i] = {lookup.idOf(edges[i].from), lookup.idOf(edges[i].to), edges[i].weight};
+    }
+    StaticGraph<N, M> g = makeStaticGraph<N>(numbered);
+    g.labels = names;
+    return g;
+}
+
+/**
+ * @brief Every shortest distance and next hop of a fixed graph, as flat N x N tables.
+ *
+ * Meant to be computed by the compiler (computeShortestPaths() in a constexpr initializer) and stored
+ * as read-only data: a lookup is then one array index, with no setup or search at runtime.
+ *
+ * @tparam N Number of nodes.
+ */
+template <std::size_t N>
+struct ShortestPathTable
+{
+    std::array<float, N * N> distances{};        ///< [from * N + to]: distance, INFINITY_VALUE if unreachable.
+    std::array<std::uint32_t, N * N> nextHops{}; ///< [from * N + to]: node after from on the path, NO_NODE if none.
+
+    /**
+     * @brief Shortest distance from -> to, or INFINITY_VALUE if to cannot be reached.
+     */
+    constexpr float distance(std::uint32_t from, std::uint32_t to) const { return distances[from * N + to]; }
+
+    /**
+     * @brief First node after from on the shortest path to to; NO_NODE if from == to or to is unreachable.
+     */
+    constexpr std::uint32_t nextHop(std::uint32_t from, std::uint32_t to) const { return nextHops[from * N + to]; }
+
+    /**
+     * @brief Writes the shortest path from -> to into out[0, length), from first, by following next hops.
+     *
+     * @return The path length, 0 if there is none. If it is larger than capacity nothing is written.
+     */
+    constexpr std::size_t pathInto(std::uint32_t from, std::uint32_t to, std::uint32_t *out,
+                                   std::size_t capacity) const
+    {
+        if (distance(from, to) == INFINITY_VALUE)
+        {
+            return 0;
+        }
+        std::size_t length = 1;
+        for (std::uint32_t node = from; node != to; node = nextHop(node, to))
+        {
+            ++length;
+        }
+        if (length <= capacity)
+        {
+            std::size_t i = 0;
+            for (std::uint32_t node = from; node != to; node = nextHop(node, to))
+            {
+                out[i++] = node;
+            }
+            out[i] = to;
+        }
+        return length;
+    }
+};
+
+/**
+ * @brief Runs Dijkstra from every node of a fixed graph and records distances and next hops.
+ *
+ * The frontier is the linear scan of the reference Dijkstra (O(N^2) per source, no heap), which is all
+ * a constant expression can afford and plenty for the tens of nodes these graphs have. The next hop of
+ * a node is inherited from its predecessor while relaxing, so no path is walked afterwards. Ties between
+ * equally short paths go to the first one found, so next hops on tied routes may differ from the CSR
+ * engines; distances do not.
+ *
+ * Compilers cap the work of one constant expression (GCC: -fconstexpr-ops-limit, Clang:
+ * -fconstexpr-steps); graphs beyond a few hundred nodes may need those raised.
+ */
+template <std::size_t N, std::size_t M>
+constexpr ShortestPathTable<N> computeShortestPaths(const StaticGraph<N, M> &g)
+{
+    ShortestPathTable<N> table{};
+    for (std::uint32_t source = 0; source < N; ++source)
+    {
+        std::array<float, N> distance{};
+        std::array<std::uint32_t, N> firstHop{};
+        std::array<bool, N> settled{};
+        for (std::uint32_t node = 0; node < N; ++node)
+        {
+            distance[node] = INFINITY_VALUE;
+            firstHop[node] = NO_NODE;
+        }
+        distance[source] = 0.0f;
+
+        for (std::size_t round = 0; round < N; ++round)
+        {
+            // Closest unsettled node; lowest id on ties, as the reference scan.
+            std::uint32_t current = NO_NODE;
+            for (std::uint32_t node = 0; node < N; ++node)
+            {
+                if (!settled[node] && distance[node] != INFINITY_VALUE &&
+                    (current == NO_NODE || distance[node] < distance[current]))
+                {
+                    current = node;
+                }
+            }
+            if (current == NO_NODE)
+            {
+                break;
+            }
+            settled[current] = true;
+            for (std::uint32_t edge = g.offsets[current]; edge < g.offsets[current + 1]; ++edge)
+            {
+                std::uint32_t next = g.targets[edge];
+                float candidate = distance[current] + g.weights[edge];
+                if (!settled[next] && candidate < distance[next])
+                {
+                    distance[next] = candidate;
+                    firstHop[next] = current == source ? next : firstHop[current];
+                }
+            }
+        }
+
+        for (std::uint32_t node = 0; node < N; ++node)
+        {
+            table.distances[source * N + node] = distance[node];
+            table.nextHops[source * N + node] = firstHop[node];
+        }
+    }
+    return table;
+}
+
+#endif // STATIC_GRAPH_HPP_
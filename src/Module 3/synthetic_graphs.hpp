@@ -0,0 +1,186 @@
+#ifndef SYNTHETIC_GRAPHS_HPP_
+#define SYNTHETIC_GRAPHS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "synthetic_random.hpp"
+
+/**
+ * @brief width x height grid with edges both ways between 4-neighbors.
+ *
+ * Node (x, y) has id y * width + x and sits at coordinate (x, y). Each direction of a street gets its
+ * own weight in [1, maxWeight), so the Euclidean and Manhattan heuristics with scale 1 are admissible.
+ */
+inline CsrGraph makeGridGraph(std::uint32_t width, std::uint32_t height, std::uint64_t seed, float maxWeight = 10.0f)
+{
+    SyntheticRandom random(seed);
+    std::vector<Edge> edges;
+    edges.reserve(std::size_t(width) * height * 4);
+    auto weight = [&]() { return static_cast<float>(random.uniform(1.0, maxWeight)); };
+    for (std::uint32_t y = 0; y < height; ++y)
+    {
+        for (std::uint32_t x = 0; x < width; ++x)
+        {
+            std::uint32_t node = y * width + x;
+            if (x + 1 < width)
+            {
+                edges.push_back({node, node + 1, weight()});
+                edges.push_back({node + 1, node, weight()});
+            }
+            if (y + 1 < height)
+            {
+                edges.push_back({node, node + width, weight()});
+                edges.push_back({node + width, node, weight()});
+            }
+        }
+    }
+    CsrGraph g = buildCsrGraph(width * height, edges);
+    g.coordinates.resize(std::size_t(width) * height);
+    for (std::uint32_t node = 0; node < width * height; ++node)
+    {
+        g.coordinates[node] = {double(node % width), double(node / width)};
+    }
+    return g;
+}
+
+/**
+ * @brief Random sparse directed graph without coordinates.
+ *
+ * Every node has an edge to the next one (so the whole graph is reachable from any node) and
+ * outDegree - 1 more edges to uniformly chosen nodes. Weights are uniform in [1, maxWeight).
+ */
+inline CsrGraph makeRandomGraph(std::uint32_t nodeCount, std::uint32_t outDegree, std::uint64_t seed,
+                                float maxWeight = 100.0f)
+{
+    SyntheticRandom random(seed);
+    std::vector<Edge> edges;
+    edges.reserve(std::size_t(nodeCount) * outDegree);
+    for (std::uint32_t node = 0; node < nodeCount; ++node)
+    {
+        edges.push_back({node, (node + 1) % nodeCount, static_cast<float>(random.uniform(1.0, maxWeight))});
+        for (std::uint32_t i = 1; i < outDegree; ++i)
+        {
+            edges.push_back({node, random.below(nodeCount), static_cast<float>(random.uniform(1.0, maxWeight))});
+        }
+    }
+    return buildCsrGraph(nodeCount, edges);
+}
+
+/**
+ * @brief Road-like graph: random points in a square, each joined both ways to its nearest neighbors.
+ *
+ * Points are spread uniformly over a square of side sqrt(nodeCount) (about one point per unit of area).
+ * Each edge costs its straight length times a detour factor in [1, 1.5), so the Euclidean heuristic with
+ * scale 1 is admissible. Like real road extracts the result is sparse, planar-ish and mostly one large
+ * component; a few small islands may be left unconnected.
+ *
+ * @param neighbors Nearest points joined to every point.
+ */
+inline CsrGraph makeRoadGraph(std::uint32_t nodeCount, std::uint64_t seed, std::uint32_t neighbors = 3)
+{
+    SyntheticRandom random(seed);
+    const double side = std::sqrt(static_cast<double>(nodeCount));
+    std::vector<Coordinate> points(nodeCount);
+    for (Coordinate &point : points)
+    {
+        point = {random.uniform(0.0, side), random.uniform(0.0, side)};
+    }
+
+    // Bucket the points into unit cells so the neighbor search only scans nearby cells.
+    const std::uint32_t cells = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(side));
+    auto cellOf = [&](double value) { return std::min(cells - 1, static_cast<std::uint32_t>(value / side * cells)); };
+    std::vector<std::uint32_t> cellStart(std::size_t(cells) * cells + 1, 0);
+    std::vector<std::uint32_t> cellPoints(nodeCount);
+    for (const Coordinate &point : points)
+    {
+        cellStart[std::size_t(cellOf(point.y)) * cells + cellOf(point.x) + 1]++;
+    }
+    for (std::size_t cell = 0; cell + 1 < cellStart.size(); ++cell)
+    {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+    std::vector<std::uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (std::uint32_t node = 0; node < nodeCount; ++node)
+    {
+        cellPoints[cursor[std::size_t(cellOf(points[node].y)) * cells + cellOf(points[node].x)]++] = node;
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(std::size_t(nodeCount) * neighbors * 2);
+    std::vector<std::pair<double, std::uint32_t>> nearest;
+    const double cellSize = side / cells;
+    for (std::uint32_t node = 0; node < nodeCount; ++node)
+    {
+        const Coordinate &point = points[node];
+        std::int64_t cx = cellOf(point.x);
+        std::int64_t cy = cellOf(point.y);
+        nearest.clear();
+        // Grow the ring of scanned cells until the k-th best candidate is closer than anything unscanned.
+        for (std::int64_t ring = 0; ring <= std::int64_t(cells); ++ring)
+        {
+            for (std::int64_t y = cy - ring; y <= cy + ring; ++y)
+            {
+                for (std::int64_t x = cx - ring; x <= cx + ring; ++x)
+                {
+                    bool onRing = y == cy - ring || y == cy + ring || x == cx - ring || x == cx + ring;
+                    if (!onRing || x < 0 || y < 0 || x >= std::int64_t(cells) || y >= std::int64_t(cells))
+                    {
+                        continue;
+                    }
+                    std::size_t cell = std::size_t(y) * cells + std::size_t(x);
+                    for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i)
+                    {
+                        std::uint32_t other = cellPoints[i];
+                        if (other == node)
+                        {
+                            continue;
+                        }
+                        double dx = points[other].x - point.x;
+                        double dy = points[other].y - point.y;
+                        nearest.push_back({dx * dx + dy * dy, other});
+                    }
+                }
+            }
+            if (nearest.size() >= neighbors)
+            {
+                std::nth_element(nearest.begin(), nearest.begin() + (neighbors - 1), nearest.end());
+                double reach = static_cast<double>(ring) * cellSize;
+                if (nearest[neighbors - 1].first <= reach * reach)
+                {
+                    break;
+                }
+            }
+        }
+        std::sort(nearest.begin(), nearest.end());
+        for (std::uint32_t i = 0; i < neighbors && i < nearest.size(); ++i)
+        {
+            float length = static_cast<float>(std::sqrt(nearest[i].first) * random.uniform(1.0, 1.5));
+            edges.push_back({node, nearest[i].second, length});
+            edges.push_back({nearest[i].second, node, length});
+        }
+    }
+
+    // Two points that pick each other get the same road twice: keep the shorter copy.
+    std::sort(edges.begin(), edges.end(),
+              [](const Edge &a, const Edge &b)
+              {
+                  if (a.from != b.from)
+                  {
+                      return a.from < b.from;
+                  }
+                  return a.to != b.to ? a.to < b.to : a.weight < b.weight;
+              });
+    edges.erase(std::unique(edges.begin(), edges.end(),
+                            [](const Edge &a, const Edge &b) { return a.from == b.from && a.to == b.to; }),
+                edges.end());
+    CsrGraph g = buildCsrGraph(nodeCount, edges);
+    g.coordinates = std::move(points);
+    return g;
+}
+
+#endif // SYNTHETIC_GRAPHS_HPP_
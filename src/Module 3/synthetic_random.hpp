@@ -0,0 +1,42 @@
+#ifndef SYNTHETIC_RANDOM_HPP_
+#define SYNTHETIC_RANDOM_HPP_
+
+#include <cstdint>
+
+/**
+ * @brief Small deterministic generator (SplitMix64) for synthetic graphs, query sets and landmark placement.
+ *
+ * The standard distributions are implementation-defined, so the numbers are derived here from the raw
+ * 64-bit output: the same seed gives the same graph with any compiler and standard library.
+ */
+class SyntheticRandom
+{
+public:
+    explicit SyntheticRandom(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Uniform double in [low, high).
+     */
+    double uniform(double low, double high)
+    {
+        return low + (high - low) * static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Uniform integer in [0, bound), bound > 0.
+     */
+    std::uint32_t below(std::uint32_t bound) { return static_cast<std::uint32_t>(next() % bound); }
+
+private:
+    std::uint64_t state;
+};
+
+#endif // SYNTHETIC_RANDOM_HPP_
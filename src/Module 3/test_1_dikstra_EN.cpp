@@ -1,360 +1,263 @@
 #include <iostream>
 #include <map>
 #include <vector>
-#include <limits> // For using maximum/minimum values
-#include <set>
-#include <algorithm> // For reverse()
 
-using namespace std;
+#include "all_pairs.hpp"
+#include "astar.hpp"
+#include "batch_query.hpp"
+#include "bidirectional_dijkstra.hpp"
+#include "contraction_hierarchy.hpp"
+#include "csr_dijkstra.hpp"
+#include "delta_stepping.hpp"
+#include "dijkstra.hpp"
+#include "graph_reorder.hpp"
+#include "landmarks.hpp"
+#include "multi_source_dijkstra.hpp"
+#include "static_graph.hpp"
 
-/**
- * @brief Constant value representing infinity.
- */
-const float INFINITY_VALUE = numeric_limits<float>::max();
+using namespace std;
 
 /**
- * @brief Class representing a point (node) in a graph.
+ * @brief Main function.
  *
- * A Point holds a node identifier and the current accumulated distance (cost) to get there.
+ * Defines an example graph, sets the start and destination nodes, and runs Dijkstra's algorithm
+ * to determine the shortest path.
+ *
+ * @return int Exit status.
  */
-class Point
+int main()
 {
-public:
-    char node;      ///< Identifier of the node.
-    float distance; ///< Distance from the starting node.
+    // Define an example graph: each node is associated with its connections and travel cost.
+    const map<char, vector<Point>> GRAPH = {
+        {'A', {{'B', 4.0}, {'C', 2.0}}},
+        {'B', {{'A', 4.0}, {'C', 1.0}, {'D', 5.0}}},
+        {'C', {{'A', 2.0}, {'B', 1.0}, {'D', 8.0}, {'E', 10.0}}},
+        {'D', {{'B', 5.0}, {'C', 8.0}, {'E', 2.0}, {'F', 6.0}}},
+        {'E', {{'C', 10.0}, {'D', 2.0}, {'F', 2.0}}},
+        {'F', {{'D', 6.0}, {'E', 2.0}}}};
+
+    // Set the starting and destination nodes.
+    char start = 'A';
+    char end = 'F';
+
+    // Create a Dijkstra object that prints every step.
+    Dijkstra<LinearScan, ConsoleTrace> dijkstra(Point(start, 0.0), Point(end, 0.0), GRAPH);
+
+    // Initialize known distances, display the graph, show visited nodes, and run the algorithm.
+    dijkstra.initializeDistances();
+    dijkstra.displayDistances();
+    dijkstra.printGraph();
+    dijkstra.displayVisited();
+    dijkstra.calculateDistances();
 
-    /**
-     * @brief Default constructor.
-     *
-     * Creates a Point with a blank node (' ') and zero distance.
-     */
-    Point() : node(' '), distance(0.0) {}
+    // Run the same query with the heap frontiers (no tracing) and check they agree with the reference scan.
+    Dijkstra<BinaryHeap> binaryHeap(Point(start, 0.0), Point(end, 0.0), GRAPH);
+    Dijkstra<QuaternaryHeap> quaternaryHeap(Point(start, 0.0), Point(end, 0.0), GRAPH);
+    Dijkstra<LazyHeap, CountingTrace> lazyHeap(Point(start, 0.0), Point(end, 0.0), GRAPH);
+    cout << endl << "Binary heap frontier:" << endl;
+    binaryHeap.initializeDistances();
+    binaryHeap.calculateDistances();
+    cout << "4-ary heap frontier:" << endl;
+    quaternaryHeap.initializeDistances();
+    quaternaryHeap.calculateDistances();
+    cout << "Lazy heap frontier:" << endl;
+    lazyHeap.initializeDistances();
+    lazyHeap.calculateDistances();
 
-    /**
-     * @brief Parameterized constructor.
-     *
-     * @param n The identifier of the node.
-     * @param d The distance (cost) associated with this node.
-     */
-    Point(char n, float d) : node(n), distance(d) {}
+    bool same = binaryHeap.reconstructPath() == dijkstra.reconstructPath() &&
+                quaternaryHeap.reconstructPath() == dijkstra.reconstructPath() &&
+                lazyHeap.reconstructPath() == dijkstra.reconstructPath();
+    cout << (same ? "All frontiers agree with the reference scan." : "Frontiers disagree with the reference scan!") << endl;
+    const CountingTrace &counts = lazyHeap.tracer();
+    cout << "Lazy heap work: " << counts.pops << " pops, " << counts.relaxations << " relaxations, " << counts.decreases
+         << " decreases, " << counts.iterations << " iterations." << endl;
 
-    /**
-     * @brief Overloads the addition operator.
-     *
-     * Although not essential for Dijkstra, this operator lets you add the distances of two points.
-     * @param other Another Point object.
-     * @return A new Point with the same node and the sum of the distances.
-     */
-    Point operator+(const Point &other) const
+    // Same graph with exact integer costs, all below 16: SmallWeight picks the O(1) bucket queue for them.
+    map<char, vector<BasicPoint<uint32_t>>> integerGraph;
+    for (const auto &node : GRAPH)
     {
-        return Point(node, distance + other.distance);
+        for (const Point &connection : node.second)
+        {
+            integerGraph[node.first].push_back({connection.node, static_cast<uint32_t>(connection.distance)});
+        }
     }
+    Dijkstra<SmallWeight<16>, NoTrace, uint32_t> integerDijkstra({start, 0}, {end, 0}, integerGraph);
+    cout << "Integer weights, bucket queue frontier:" << endl;
+    integerDijkstra.initializeDistances();
+    integerDijkstra.calculateDistances();
 
-    /**
-     * @brief Overloaded input operator.
-     *
-     * Allows formatted input for a Point.
-     * @param is Input stream.
-     * @param p Point object to fill.
-     * @return Reference to the input stream.
-     */
-    friend istream &operator>>(istream &is, Point &p)
+    // Pack the graph into CSR form and run the array-based engine on it.
+    CsrGraph csr = buildCsrGraph(GRAPH);
+    CsrDijkstra<> csrDijkstra(csr.view());
+    csrDijkstra.run(csr.idOf(start), csr.idOf(end));
+    cout << "CSR engine path (cost " << csrDijkstra.distance(csr.idOf(end)) << "):" << endl;
+    uint32_t route[16]; // Caller-owned buffer: no allocation to get the path out.
+    size_t routeLength = csrDijkstra.pathInto(csr.idOf(end), route, 16);
+    for (size_t i = 0; i < routeLength && routeLength <= 16; ++i)
     {
-        cout << "Enter the node (character): ";
-        is >> p.node;
-        cout << "Enter the distance (floating point number): ";
-        is >> p.distance;
-        return is;
+        cout << csr.labels[route[i]] << " ";
     }
+    cout << endl;
 
-    /**
-     * @brief Overloaded output operator.
-     *
-     * Allows formatted output of a Point.
-     * @param os Output stream.
-     * @param p Point object to print.
-     * @return Reference to the output stream.
-     */
-    friend ostream &operator<<(ostream &os, const Point &p)
+    // Renumber the nodes for locality; the search still takes and returns the original ids.
+    ReorderedGraph reordered = reorderGraph(csr, NodeOrder::ReverseCuthillMcKee);
+    RenumberedSearch<> renumbered(reordered);
+    renumbered.run(csr.idOf(start), csr.idOf(end));
+    cout << "Renumbered (RCM) engine path (cost " << renumbered.distance(csr.idOf(end)) << "):" << endl;
+    for (uint32_t id : renumbered.path(csr.idOf(end)))
     {
-        os << "Node: " << p.node << ", Distance: " << p.distance;
-        return os;
+        cout << csr.labels[id] << " ";
     }
-};
-
-/**
- * @brief Class implementing Dijkstra's algorithm for finding the shortest path.
- *
- * This class calculates the optimal path between a starting node and a destination node in a graph.
- * It uses a debug mode (controlled with a flag) to print detailed messages during each algorithm step.
- */
-class Dijkstra
-{
-private:
-    map<char, Point> distances;   ///< Map holding the accumulated cost for each node.
-    set<char> visited;            ///< Set of nodes that have already been processed.
-    map<char, char> predecessors; ///< Map to store the previous node for each node in the optimal path.
-    bool debug;                   ///< Flag to indicate whether debug messages are printed.
-
-public:
-    Point startNode;                ///< The starting point.
-    Point endNode;                  ///< The destination point.
-    map<char, vector<Point>> graph; ///< Graph: each node maps to a vector of connections (neighbor and cost).
+    cout << endl;
 
-    /**
-     * @brief Constructor for the Dijkstra algorithm class.
-     *
-     * Initializes the algorithm with the start node, destination node, the graph, and the debug flag.
-     *
-     * @param start The starting node.
-     * @param end The destination node.
-     * @param g The graph represented as a map.
-     * @param debugMode Set to true to enable detailed debug messages.
-     */
-    Dijkstra(const Point &start, const Point &end, const map<char, vector<Point>> &g, bool debugMode = true)
-        : startNode(start), endNode(end), graph(g), debug(debugMode) {}
-
-    /**
-     * @brief Prints the graph.
-     *
-     * Displays every node and its connections (like looking at a simple map of neighbors).
-     */
-    void printGraph() const
+    // Answer every (start, end) pair as one batch and check it against the single-threaded engine.
+    vector<Query> queries;
+    for (uint32_t from = 0; from < csr.nodeCount(); ++from)
     {
-        for (const auto &node : graph)
+        for (uint32_t to = 0; to < csr.nodeCount(); ++to)
         {
-            cout << "Node: " << node.first << " Connections:" << endl;
-            for (const auto &connection : node.second)
-            {
-                cout << "  [" << connection.node << ", " << connection.distance << "]" << endl;
-            }
-            cout << endl;
+            queries.push_back({from, to});
         }
     }
-
-    /**
-     * @brief Displays the visited nodes.
-     *
-     * Prints all nodes that have already been processed.
-     */
-    void displayVisited() const
+    BatchQueryEngine<> batch(csr.view());
+    vector<QueryResult> answers = batch.answer(queries);
+    bool batchMatches = true;
+    for (size_t i = 0; i < queries.size(); ++i)
     {
-        cout << "Visited nodes: ";
-        for (const char &node : visited)
-        {
-            cout << node << " ";
-        }
-        cout << endl;
+        csrDijkstra.run(queries[i].source, queries[i].target);
+        batchMatches = batchMatches && answers[i].distance == csrDijkstra.distance(queries[i].target) &&
+                       answers[i].path == csrDijkstra.path(queries[i].target);
     }
+    cout << queries.size() << " batched queries on " << batch.threadCount() << " threads "
+         << (batchMatches ? "match" : "do not match") << " the single-threaded engine." << endl;
 
-    /**
-     * @brief Initializes the distances for each node.
-     *
-     * Sets the starting node's distance to 0 and every other node's distance to infinity.
-     * Think of this as knowing your home's distance (0) while all other locations are unknown (infinity).
-     */
-    void initializeDistances()
+    // Full shortest-path tree by parallel delta-stepping: same distances as the sequential engine.
+    DeltaStepping deltaStepping(csr.view());
+    deltaStepping.run(csr.idOf(start));
+    csrDijkstra.run(csr.idOf(start));
+    bool treeMatches = true;
+    for (uint32_t id = 0; id < csr.nodeCount(); ++id)
     {
-        for (const auto &node : graph)
-        {
-            char key = node.first;
-            distances[key] = (key == startNode.node) ? Point(key, 0.0) : Point(key, INFINITY_VALUE);
-        }
+        treeMatches = treeMatches && deltaStepping.distance(id) == csrDijkstra.distance(id);
     }
+    cout << "Delta-stepping tree (delta " << deltaStepping.delta() << ", " << deltaStepping.phaseCount() << " phases) "
+         << (treeMatches ? "matches" : "does not match") << " the sequential distances." << endl;
 
-    /**
-     * @brief Displays the current accumulated cost to each node.
-     *
-     * Shows the cost (distance) accumulated so far to reach every node.
-     */
-    void displayDistances() const
+    // Whole distance table at once with the tiled Floyd-Warshall.
+    AllPairsMatrix table = AllPairsMatrix::compute(csr.view());
+    cout << "All-pairs table (" << simdLevelName(table.simdLevel()) << "): "
+         << start << " -> " << end << " costs " << table.distance(csr.idOf(start), csr.idOf(end)) << ", path:";
+    for (uint32_t id : table.path(csr.idOf(start), csr.idOf(end)))
     {
-        for (const auto &pair : distances)
-        {
-            cout << "Node: " << pair.first << ", Distance: " << pair.second.distance << endl;
-        }
+        cout << " " << csr.labels[id];
     }
+    cout << endl;
 
-    /**
-     * @brief Retrieves the unvisited node with the minimum provisional distance.
-     *
-     * Iterates over all nodes and selects the one that is unvisited and has the smallest known cost.
-     * Think of it as finding the shortest unexplored road.
-     *
-     * @return The node identifier with the smallest accumulated cost, or ' ' if none is found.
-     */
-    char getMinimumNode()
+    // Search from both ends at once over the graph and its reverse.
+    CsrGraph reverseCsr = reverseGraph(csr.view());
+    BidirectionalDijkstra<> bidirectional(csr.view(), reverseCsr.view());
+    bidirectional.run(csr.idOf(start), csr.idOf(end));
+    cout << "Bidirectional path (cost " << bidirectional.distance() << ", " << bidirectional.settledCount()
+         << " nodes settled):" << endl;
+    for (uint32_t id : bidirectional.path())
     {
-        float minValue = INFINITY_VALUE;
-        char minNode = ' ';
-        for (const auto &pair : distances)
-        {
-            if (visited.find(pair.first) == visited.end() && pair.second.distance < minValue)
-            {
-                minValue = pair.second.distance;
-                minNode = pair.first;
-            }
-        }
-        return minNode;
+        cout << csr.labels[id] << " ";
     }
+    cout << endl;
 
-    /**
-     * @brief Updates the distances of the nodes adjacent to the current node.
-     *
-     * For each neighbor of the current node, if traveling through the current node offers a cheaper path,
-     * update the neighbor's cost and mark the current node as its predecessor.
-     *
-     * @param currentNode The node from which to update neighboring nodes.
-     */
-    void updateDistances(char currentNode)
+    // Place the nodes on a line (no edge is shorter than the gap between its ends) and run A*.
+    csr.coordinates = {{0, 0}, {3, 0}, {2, 0}, {7, 0}, {9, 0}, {11, 0}}; // A, B, C, D, E, F
+    AStar<EuclideanHeuristic> astar(csr.view(), EuclideanHeuristic(csr.view().coordinates));
+    astar.run(csr.idOf(start), csr.idOf(end));
+    cout << "A* path (cost " << astar.distance(csr.idOf(end)) << ", " << astar.settledCount()
+         << " nodes settled):" << endl;
+    for (uint32_t id : astar.path(csr.idOf(end)))
     {
-        // Loop through each connection (edge) from the current node.
-        for (const auto &connection : graph[currentNode])
-        {
-            if (visited.find(connection.node) == visited.end())
-            {
-                // Calculate new distance: cost so far + cost from current to neighbor.
-                float newDistance = distances[currentNode].distance + connection.distance;
-                // If the new found path is shorter, update the cost for the neighbor.
-                if (newDistance < distances[connection.node].distance)
-                {
-                    distances[connection.node].distance = newDistance;
-                    predecessors[connection.node] = currentNode; // Record the predecessor.
-                }
-            }
-        }
+        cout << csr.labels[id] << " ";
     }
+    cout << endl;
 
-    /**
-     * @brief Reconstructs the shortest path from the destination back to the source.
-     *
-     * Walk backwards from the end node using the predecessor map until the start node is reached.
-     *
-     * @return A vector of node identifiers representing the shortest path.
-     */
-    vector<char> reconstructPath() const
+    // ALT: the same A* guided by distances to two landmarks instead of coordinates.
+    LandmarkOptions landmarkOptions;
+    landmarkOptions.count = 2;
+    LandmarkTable landmarks = LandmarkTable::build(csr.view(), landmarkOptions);
+    AStar<LandmarkHeuristic> alt(csr.view(), LandmarkHeuristic(landmarks));
+    alt.run(csr.idOf(start), csr.idOf(end));
+    cout << "ALT path (cost " << alt.distance(csr.idOf(end)) << ", landmarks";
+    for (uint32_t id : landmarks.landmarks)
     {
-        vector<char> path;
-        char current = endNode.node;
-        // Trace steps back until the starting node is reached.
-        while (current != startNode.node)
-        {
-            path.push_back(current);
-            // If a link is missing, then the path does not exist.
-            if (predecessors.find(current) == predecessors.end())
-            {
-                return vector<char>(); // An empty vector indicates an error.
-            }
-            current = predecessors.at(current);
-        }
-        path.push_back(startNode.node);
-        // Reverse the path to make it run from start to destination.
-        reverse(path.begin(), path.end());
-        return path;
+        cout << " " << csr.labels[id];
     }
-
-    /**
-     * @brief Executes Dijkstra's algorithm.
-     *
-     * The algorithm performs the following steps:
-     * 1. Find the unvisited node with the smallest distance.
-     * 2. Mark that node as visited (it will not be checked again).
-     * 3. Update (relax) the distances for each of its neighboring nodes.
-     * 4. Repeat until all nodes are visited or the destination is reached.
-     *
-     * Debug mode outputs detailed information for every step executed.
-     */
-    void calculateDistances()
+    cout << ", " << alt.settledCount() << " nodes settled):" << endl;
+    for (uint32_t id : alt.path(csr.idOf(end)))
     {
-        int iteration = 0;
-        while (visited.size() < distances.size())
-        {
-            // Step 1: Find the unvisited node with the smallest accumulated cost.
-            char current = getMinimumNode();
-            if (current == ' ')
-                break; // No reachable unvisited node is found.
+        cout << csr.labels[id] << " ";
+    }
+    cout << endl;
 
-            // Mark the current node as visited.
-            visited.insert(current);
-            iteration++;
-            if (debug)
-            {
-                cout << "Iteration " << iteration << ": Node " << current << " selected." << endl;
-            }
+    // Preprocess once into a contraction hierarchy, then answer the query with two upward searches.
+    ContractionHierarchy hierarchy = ContractionHierarchy::build(csr.view());
+    HierarchyQuery<> hierarchyQuery(hierarchy);
+    hierarchyQuery.run(csr.idOf(start), csr.idOf(end));
+    cout << "Contraction hierarchy path (cost " << hierarchyQuery.distance() << ", " << hierarchy.shortcutCount
+         << " shortcuts, " << hierarchyQuery.settledCount() << " nodes settled):" << endl;
+    for (uint32_t id : hierarchyQuery.path())
+    {
+        cout << csr.labels[id] << " ";
+    }
+    cout << endl;
 
-            // Step 2: If the current node is the destination, then stop.
-            if (current == endNode.node)
-            {
-                if (debug)
-                {
-                    cout << "Destination node reached." << endl;
-                }
-                break;
-            }
+    // Nearest depot for every node, with one search seeded from all the depots.
+    vector<uint32_t> depots = {csr.idOf('A'), csr.idOf('F')};
+    MultiSourceDijkstra<> nearestDepot(csr.view());
+    nearestDepot.run(depots);
+    cout << "Nearest depot (A or F):";
+    for (uint32_t id = 0; id < csr.nodeCount(); ++id)
+    {
+        cout << " " << csr.labels[id] << "->" << csr.labels[nearestDepot.nearestSource(id)] << " ("
+             << nearestDepot.distance(id) << ")";
+    }
+    cout << endl;
 
-            // Step 3: Update the distances for each neighbor of the current node.
-            updateDistances(current);
-            if (debug)
-            {
-                cout << "Updated distances:" << endl;
-                displayDistances();
-            }
-        }
-        if (debug)
-        {
-            cout << "Total iterations: " << iteration << endl;
-        }
+    // Service area: every node within a travel budget of the start, closest first.
+    const float budget = 5.0f;
+    vector<ReachedNode> area;
+    csrDijkstra.runWithin(csr.idOf(start), budget, area);
+    cout << "Within " << budget << " of " << start << ":";
+    for (const ReachedNode &reached : area)
+    {
+        cout << " " << csr.labels[reached.node] << " (" << reached.distance << ")";
+    }
+    cout << endl;
 
-        // Reconstruct and print the shortest path.
-        vector<char> path = reconstructPath();
-        if (!path.empty())
-        {
-            cout << "Shortest path:" << endl;
-            for (char n : path)
-            {
-                cout << n << " ";
-            }
-            cout << endl;
-        }
-        else
+    // The same graph fixed at compile time: the compiler runs every search and the tables are read-only data.
+    static constexpr auto FIXED_GRAPH = makeStaticGraph(
+        "ABCDEF", {{'A', 'B', 4.0f}, {'A', 'C', 2.0f}, {'B', 'A', 4.0f}, {'B', 'C', 1.0f}, {'B', 'D', 5.0f},
+                   {'C', 'A', 2.0f}, {'C', 'B', 1.0f}, {'C', 'D', 8.0f}, {'C', 'E', 10.0f}, {'D', 'B', 5.0f},
+                   {'D', 'C', 8.0f}, {'D', 'E', 2.0f}, {'D', 'F', 6.0f}, {'E', 'C', 10.0f}, {'E', 'D', 2.0f},
+                   {'E', 'F', 2.0f}, {'F', 'D', 6.0f}, {'F', 'E', 2.0f}});
+    static constexpr auto FIXED_TABLE = computeShortestPaths(FIXED_GRAPH);
+    static_assert(FIXED_TABLE.distance(FIXED_GRAPH.idOf('A'), FIXED_GRAPH.idOf('F')) == 12.0f,
+                  "A -> F is computed by the compiler");
+    cout << "Compile-time table: " << start << " -> " << end << " costs "
+         << FIXED_TABLE.distance(FIXED_GRAPH.idOf(start), FIXED_GRAPH.idOf(end)) << ", path:";
+    size_t fixedLength = FIXED_TABLE.pathInto(FIXED_GRAPH.idOf(start), FIXED_GRAPH.idOf(end), route, 16);
+    for (size_t i = 0; i < fixedLength && fixedLength <= 16; ++i)
+    {
+        cout << " " << FIXED_GRAPH.labels[route[i]];
+    }
+    bool fixedMatches = true;
+    for (uint32_t from = 0; from < csr.nodeCount(); ++from)
+    {
+        csrDijkstra.run(from);
+        for (uint32_t to = 0; to < csr.nodeCount(); ++to)
         {
-            cout << "No path found to the destination." << endl;
+            fixedMatches = fixedMatches && FIXED_TABLE.distance(FIXED_GRAPH.idOf(csr.labels[from]),
+                                                                FIXED_GRAPH.idOf(csr.labels[to])) ==
+                                               csrDijkstra.distance(to);
         }
     }
-};
-
-/**
- * @brief Main function.
- *
- * Defines an example graph, sets the start and destination nodes, and runs Dijkstra's algorithm
- * to determine the shortest path.
- *
- * @return int Exit status.
- */
-int main()
-{
-    // Define an example graph: each node is associated with its connections and travel cost.
-    const map<char, vector<Point>> GRAPH = {
-        {'A', {{'B', 4.0}, {'C', 2.0}}},
-        {'B', {{'A', 4.0}, {'C', 1.0}, {'D', 5.0}}},
-        {'C', {{'A', 2.0}, {'B', 1.0}, {'D', 8.0}, {'E', 10.0}}},
-        {'D', {{'B', 5.0}, {'C', 8.0}, {'E', 2.0}, {'F', 6.0}}},
-        {'E', {{'C', 10.0}, {'D', 2.0}, {'F', 2.0}}},
-        {'F', {{'D', 6.0}, {'E', 2.0}}}};
-
-    // Set the starting and destination nodes.
-    char start = 'A';
-    char end = 'F';
-
-    // Create a Dijkstra object with debug mode enabled.
-    Dijkstra dijkstra(Point(start, 0.0), Point(end, 0.0), GRAPH, true);
-
-    // Initialize known distances, display the graph, show visited nodes, and run the algorithm.
-    dijkstra.initializeDistances();
-    dijkstra.displayDistances();
-    dijkstra.printGraph();
-    dijkstra.displayVisited();
-    dijkstra.calculateDistances();
+    cout << " (" << (fixedMatches ? "matches" : "does not match") << " the runtime engine)" << endl;
 
     return 0;
 }
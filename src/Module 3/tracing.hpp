@@ -0,0 +1,211 @@
+#ifndef TRACING_HPP_
+#define TRACING_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief Tracing policies for the Dijkstra engines.
+ *
+ * An engine takes its tracer as a template parameter and calls these hooks at fixed points of the search:
+ *  - pop(node, key): an entry left the frontier (including outdated copies of a lazy heap);
+ *  - iteration(count, node): node was selected and marked visited (settled);
+ *  - relax(from, to, distance): an edge of a settled node was examined;
+ *  - decrease(node, distance): that relaxation lowered the node's distance;
+ *  - reachedTarget(node): the destination was settled;
+ *  - updated(engine): the neighbors of the current node were all relaxed;
+ *  - finished(iterations): the search loop ended.
+ * Nodes and distances are passed in the engine's own types (char labels or 32-bit ids; float, double or
+ * integer weights).
+ *
+ * Since the policy is a type, the choice is made at compile time: with NoTrace every hook is an empty
+ * inline function and the optimizer removes the calls and their arguments, so a production build runs
+ * the same code as if tracing did not exist.
+ */
+
+/**
+ * @brief Tracing disabled: every hook compiles to nothing.
+ */
+struct NoTrace
+{
+    template <typename Node, typename Distance>
+    void pop(Node, Distance) {}
+    template <typename Node>
+    void iteration(std::uint32_t, Node) {}
+    template <typename Node, typename Distance>
+    void relax(Node, Node, Distance) {}
+    template <typename Node, typename Distance>
+    void decrease(Node, Distance) {}
+    template <typename Node>
+    void reachedTarget(Node) {}
+    template <typename Engine>
+    void updated(const Engine &) {}
+    void finished(std::uint32_t) {}
+};
+
+/**
+ * @brief Counts the work done by a search. Counters add up over runs until reset().
+ */
+struct CountingTrace : NoTrace
+{
+    std::uint64_t pops = 0;        ///< Entries taken from the frontier.
+    std::uint64_t relaxations = 0; ///< Edges examined.
+    std::uint64_t decreases = 0;   ///< Relaxations that lowered a distance.
+    std::uint64_t iterations = 0;  ///< Nodes settled.
+
+    template <typename Node, typename Distance>
+    void pop(Node, Distance) { pops++; }
+    template <typename Node>
+    void iteration(std::uint32_t, Node) { iterations++; }
+    template <typename Node, typename Distance>
+    void relax(Node, Node, Distance) { relaxations++; }
+    template <typename Node, typename Distance>
+    void decrease(Node, Distance) { decreases++; }
+
+    void reset() { *this = CountingTrace(); }
+};
+
+/**
+ * @brief One recorded step of a search.
+ */
+struct TraceEvent
+{
+    enum Kind : std::uint8_t
+    {
+        POP,
+        ITERATION,
+        RELAX,
+        DECREASE,
+        TARGET,
+        FINISHED
+    };
+
+    Kind kind;          ///< What happened.
+    std::uint32_t node; ///< Node concerned (head of the edge for RELAX).
+    std::uint32_t from; ///< Tail of the edge for RELAX, iteration number for ITERATION, else 0.
+    float value;        ///< Distance or key involved (converted to float), 0 if none.
+};
+
+/**
+ * @brief Keeps the last Capacity events in a fixed ring buffer, to be dumped after the run.
+ *
+ * Recording is a store into a preallocated array: no allocation, no I/O, no flush in the hot loop.
+ *
+ * @tparam Capacity Number of most recent events kept.
+ */
+template <std::size_t Capacity = 4096>
+class EventLogTrace : public NoTrace
+{
+    static_assert(Capacity > 0, "The ring buffer needs at least one slot.");
+
+public:
+    template <typename Node, typename Distance>
+    void pop(Node node, Distance key) { record(TraceEvent::POP, id(node), 0, static_cast<float>(key)); }
+    template <typename Node>
+    void iteration(std::uint32_t count, Node node) { record(TraceEvent::ITERATION, id(node), count, 0.0f); }
+    template <typename Node, typename Distance>
+    void relax(Node from, Node to, Distance distance)
+    {
+        record(TraceEvent::RELAX, id(to), id(from), static_cast<float>(distance));
+    }
+    template <typename Node, typename Distance>
+    void decrease(Node node, Distance distance)
+    {
+        record(TraceEvent::DECREASE, id(node), 0, static_cast<float>(distance));
+    }
+    template <typename Node>
+    void reachedTarget(Node node) { record(TraceEvent::TARGET, id(node), 0, 0.0f); }
+    void finished(std::uint32_t iterations) { record(TraceEvent::FINISHED, 0, iterations, 0.0f); }
+
+    /**
+     * @brief Events recorded since the last clear(), including the ones overwritten.
+     */
+    std::uint64_t recorded() const { return total; }
+
+    /**
+     * @brief Number of events currently held (at most Capacity).
+     */
+    std::size_t size() const { return total < Capacity ? static_cast<std::size_t>(total) : Capacity; }
+
+    /**
+     * @brief i-th held event, oldest first.
+     */
+    const TraceEvent &operator[](std::size_t i) const
+    {
+        std::size_t first = total < Capacity ? 0 : total % Capacity;
+        return events[(first + i) % Capacity];
+    }
+
+    void clear() { total = 0; }
+
+    /**
+     * @brief Writes the held events, oldest first, one per line.
+     */
+    void dump(std::ostream &out) const
+    {
+        static const char *const NAMES[] = {"pop", "iteration", "relax", "decrease", "target", "finished"};
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            const TraceEvent &event = (*this)[i];
+            out << NAMES[event.kind] << " node=" << event.node << " from=" << event.from << " value=" << event.value
+                << '\n';
+        }
+        out.flush();
+    }
+
+private:
+    std::array<TraceEvent, Capacity> events; ///< Ring buffer.
+    std::uint64_t total = 0;                 ///< Events ever recorded since clear().
+
+    template <typename Node>
+    static std::uint32_t id(Node node)
+    {
+        return static_cast<std::uint32_t>(node);
+    }
+
+    static std::uint32_t id(char node) { return static_cast<unsigned char>(node); }
+
+    void record(TraceEvent::Kind kind, std::uint32_t node, std::uint32_t from, float value)
+    {
+        events[total % Capacity] = {kind, node, from, value};
+        total++;
+    }
+};
+
+/**
+ * @brief Prints the step-by-step messages of the former debug mode to std::cout.
+ *
+ * Same text as before (selected node, destination reached, distance table after every update, total
+ * iterations), but lines end with '\n' and the stream is flushed once, when the search finishes.
+ */
+struct ConsoleTrace : NoTrace
+{
+    template <typename Node>
+    void iteration(std::uint32_t count, Node node)
+    {
+        std::cout << "Iteration " << count << ": Node " << node << " selected.\n";
+    }
+
+    template <typename Node>
+    void reachedTarget(Node)
+    {
+        std::cout << "Destination node reached.\n";
+    }
+
+    template <typename Engine>
+    void updated(const Engine &engine)
+    {
+        std::cout << "Updated distances:\n";
+        engine.displayDistances(std::cout);
+    }
+
+    void finished(std::uint32_t iterations)
+    {
+        std::cout << "Total iterations: " << iterations << '\n';
+        std::cout.flush();
+    }
+};
+
+#endif // TRACING_HPP_
@@ -0,0 +1,77 @@
+#include "all_pairs.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Compares every entry of the matrix with a Dijkstra run from its row, paths included.
+ */
+void expectSameAsDijkstra(const CsrGraph &graph, const AllPairsMatrix &matrix)
+{
+    ASSERT_EQ(matrix.nodeCount(), graph.nodeCount());
+    CsrDijkstra<> reference(graph.view());
+    for (std::uint32_t from = 0; from < graph.nodeCount(); ++from)
+    {
+        reference.run(from);
+        for (std::uint32_t to = 0; to < graph.nodeCount(); ++to)
+        {
+            float expected = reference.distance(to);
+            if (expected == INFINITY_VALUE)
+            {
+                ASSERT_EQ(matrix.distance(from, to), INFINITY_VALUE) << from << " -> " << to;
+                EXPECT_TRUE(matrix.path(from, to).empty());
+                continue;
+            }
+            ASSERT_NEAR(matrix.distance(from, to), expected, sumTolerance(expected)) << from << " -> " << to;
+            std::vector<std::uint32_t> path = matrix.path(from, to);
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(path.front(), from);
+            EXPECT_EQ(path.back(), to);
+            EXPECT_NEAR(pathCost(graph.view(), path), expected, sumTolerance(expected)) << from << " -> " << to;
+        }
+    }
+}
+
+} // namespace
+
+TEST(AllPairsMatrixTest, MatchesDijkstraAcrossSeveralTiles)
+{
+    // 150 nodes: two full tiles and a partial one.
+    const CsrGraph graph = makeRandomGraph(150, 4, 12);
+    expectSameAsDijkstra(graph, AllPairsMatrix::compute(graph.view()));
+}
+
+TEST(AllPairsMatrixTest, MatchesDijkstraWithUnreachablePairs)
+{
+    const CsrGraph graph = makeRoadGraph(90, 3, 1);
+    AllPairsOptions options;
+    options.threads = 3;
+    expectSameAsDijkstra(graph, AllPairsMatrix::compute(graph.view(), options));
+}
+
+TEST(AllPairsMatrixTest, ScalarAndVectorKernelsGiveTheSameTable)
+{
+    const CsrGraph graph = makeGridGraph(11, 9, 7);
+    AllPairsOptions scalar;
+    scalar.allowSimd = false;
+    const AllPairsMatrix vectorTable = AllPairsMatrix::compute(graph.view());
+    const AllPairsMatrix scalarTable = AllPairsMatrix::compute(graph.view(), scalar);
+    EXPECT_EQ(scalarTable.simdLevel(), SimdLevel::Scalar);
+    for (std::uint32_t from = 0; from < graph.nodeCount(); ++from)
+    {
+        for (std::uint32_t to = 0; to < graph.nodeCount(); ++to)
+        {
+            ASSERT_EQ(vectorTable.distance(from, to), scalarTable.distance(from, to)) << from << " -> " << to;
+            ASSERT_EQ(vectorTable.predecessor(from, to), scalarTable.predecessor(from, to)) << from << " -> " << to;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include "astar.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Runs A* from a few sources to every node and compares with Dijkstra (heuristic set to zero).
+ */
+template <typename Heuristic>
+void expectSameDistances(const CsrGraph &graph, Heuristic heuristic, std::uint32_t sourceStep)
+{
+    AStar<Heuristic> astar(graph.view(), heuristic);
+    expectMatchesDijkstra(
+        graph, [&](std::uint32_t source, std::uint32_t target) { return astar.run(source, target); },
+        [&](std::uint32_t target) { return astar.path(target); }, sourceStep, true);
+}
+
+} // namespace
+
+TEST(AStarTest, EuclideanMatchesDijkstraOnARoadGraph)
+{
+    const CsrGraph graph = makeRoadGraph(300, 6);
+    expectSameDistances(graph, EuclideanHeuristic(graph.coordinates.data()), 29);
+}
+
+TEST(AStarTest, ManhattanMatchesDijkstraOnAGrid)
+{
+    const CsrGraph graph = makeGridGraph(15, 12, 3);
+    expectSameDistances(graph, ManhattanHeuristic(graph.coordinates.data()), 31);
+}
+
+TEST(AStarTest, ZeroHeuristicIsPlainDijkstra)
+{
+    expectSameDistances(makeRandomGraph(150, 3, 5), ZeroHeuristic(), 13);
+}
+
+TEST(AStarTest, HeuristicSettlesFewerNodes)
+{
+    const CsrGraph graph = makeGridGraph(40, 40, 9);
+    AStar<EuclideanHeuristic> guided(graph.view(), EuclideanHeuristic(graph.coordinates.data()));
+    AStar<ZeroHeuristic> blind(graph.view(), ZeroHeuristic());
+    guided.run(0, 41);
+    blind.run(0, 41);
+    EXPECT_LT(guided.settledCount(), blind.settledCount());
+}
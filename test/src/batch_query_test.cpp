@@ -0,0 +1,128 @@
+#include "batch_query.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::vector<Query> randomQueries(unsigned seed, std::uint32_t nodes, std::size_t count)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::uint32_t> pick(0, nodes - 1);
+    std::vector<Query> queries(count);
+    for (Query &query : queries)
+    {
+        query.source = pick(random);
+        query.target = pick(random);
+    }
+    return queries;
+}
+
+} // namespace
+
+TEST(BatchQueryEngineTest, MatchesTheSingleThreadedEngineForAnyThreadCount)
+{
+    const CsrGraph graph = randomCsrGraph(3, 400, 1600);
+    const std::vector<Query> queries = randomQueries(5, graph.nodeCount(), 300);
+
+    CsrDijkstra<> single(graph.view());
+    std::vector<float> distances;
+    std::vector<std::vector<std::uint32_t>> paths;
+    for (const Query &query : queries)
+    {
+        single.run(query.source, query.target);
+        distances.push_back(single.distance(query.target));
+        paths.push_back(single.path(query.target));
+    }
+
+    for (unsigned threads : {1u, 2u, 4u})
+    {
+        BatchQueryEngine<> batch(graph.view(), threads);
+        EXPECT_EQ(batch.threadCount(), threads);
+        for (int repeat = 0; repeat < 3; ++repeat)
+        {
+            std::vector<QueryResult> results = batch.answer(queries);
+            ASSERT_EQ(results.size(), queries.size());
+            for (std::size_t i = 0; i < queries.size(); ++i)
+            {
+                EXPECT_EQ(results[i].distance, distances[i]) << threads << " threads, query " << i;
+                EXPECT_EQ(results[i].path, paths[i]) << threads << " threads, query " << i;
+            }
+        }
+    }
+}
+
+TEST(BatchQueryEngineTest, DistanceOnlyWorkersGiveTheSameDistances)
+{
+    const CsrGraph graph = randomCsrGraph(9, 300, 1000);
+    const std::vector<Query> queries = randomQueries(2, graph.nodeCount(), 200);
+    BatchQueryEngine<> full(graph.view(), 2);
+    BatchQueryEngine<BinaryHeap, false> distanceOnly(graph.view(), 3);
+    std::vector<QueryResult> expected = full.answer(queries);
+    std::vector<QueryResult> results = distanceOnly.answer(queries);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        EXPECT_EQ(results[i].distance, expected[i].distance) << "query " << i;
+        EXPECT_TRUE(results[i].path.empty());
+    }
+}
+
+TEST(BatchQueryEngineTest, AnswerIntoWritesStridedPaths)
+{
+    const CsrGraph graph = randomCsrGraph(4, 300, 1200);
+    const std::vector<Query> queries = randomQueries(8, graph.nodeCount(), 150);
+    BatchQueryEngine<> batch(graph.view(), 3);
+    std::vector<QueryResult> expected = batch.answer(queries);
+
+    // A stride of 4 is too short for some paths: those are not written, but their length is reported.
+    const std::size_t stride = 4;
+    const std::uint32_t untouched = 0xDEADBEEFu;
+    std::vector<float> distances(queries.size());
+    std::vector<std::uint32_t> lengths(queries.size());
+    std::vector<std::uint32_t> paths(queries.size() * stride, untouched);
+    batch.answerInto(queries, distances.data(), lengths.data(), paths.data(), stride);
+
+    std::size_t tooLong = 0;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        EXPECT_EQ(distances[i], expected[i].distance) << "query " << i;
+        ASSERT_EQ(lengths[i], expected[i].path.size()) << "query " << i;
+        const std::uint32_t *slot = paths.data() + i * stride;
+        if (lengths[i] > stride)
+        {
+            tooLong++;
+            for (std::size_t k = 0; k < stride; ++k)
+            {
+                EXPECT_EQ(slot[k], untouched) << "query " << i;
+            }
+            continue;
+        }
+        EXPECT_EQ(std::vector<std::uint32_t>(slot, slot + lengths[i]), expected[i].path) << "query " << i;
+    }
+    EXPECT_GT(tooLong, 0u);
+}
+
+TEST(BatchQueryEngineTest, AnswerIntoNeedsBothPathArrays)
+{
+    const CsrGraph graph = randomCsrGraph(6, 100, 400);
+    const std::vector<Query> queries = randomQueries(1, graph.nodeCount(), 40);
+    BatchQueryEngine<> batch(graph.view(), 2);
+    std::vector<QueryResult> expected = batch.answer(queries, false);
+
+    std::vector<float> distances(queries.size());
+    std::vector<std::uint32_t> paths(queries.size() * 8, 7u);
+    batch.answerInto(queries, distances.data(), nullptr, paths.data(), 8);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        EXPECT_EQ(distances[i], expected[i].distance) << "query " << i;
+    }
+    EXPECT_EQ(paths, std::vector<std::uint32_t>(queries.size() * 8, 7u));
+}
@@ -0,0 +1,42 @@
+#include "bidirectional_dijkstra.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Runs queries from a few sources to every node and compares with the one-sided search.
+ */
+void expectSameDistances(const CsrGraph &graph, std::uint32_t sourceStep)
+{
+    const CsrGraph backward = reverseGraph(graph.view());
+    BidirectionalDijkstra<> bidirectional(graph.view(), backward.view());
+    expectMatchesDijkstra(
+        graph, [&](std::uint32_t source, std::uint32_t target) { return bidirectional.run(source, target); },
+        [&](std::uint32_t) { return bidirectional.path(); }, sourceStep);
+}
+
+} // namespace
+
+TEST(BidirectionalDijkstraTest, MatchesDijkstraOnAGrid)
+{
+    expectSameDistances(makeGridGraph(12, 10, 1), 17);
+}
+
+TEST(BidirectionalDijkstraTest, MatchesDijkstraOnARoadGraphWithIslands)
+{
+    expectSameDistances(makeRoadGraph(300, 4, 2), 23);
+}
+
+TEST(BidirectionalDijkstraTest, MatchesDijkstraOnADirectedGraph)
+{
+    expectSameDistances(makeRandomGraph(200, 3, 8), 19);
+}
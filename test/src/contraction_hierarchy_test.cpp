@@ -0,0 +1,46 @@
+#include "contraction_hierarchy.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Builds the hierarchy and runs queries from a few sources to every node against Dijkstra.
+ */
+void expectSameDistances(const CsrGraph &graph, unsigned threads, std::uint32_t sourceStep)
+{
+    ContractionOptions options;
+    options.threads = threads;
+    const ContractionHierarchy hierarchy = ContractionHierarchy::build(graph.view(), options);
+    ASSERT_EQ(hierarchy.nodeCount(), graph.nodeCount());
+
+    HierarchyQuery<> query(hierarchy);
+    expectMatchesDijkstra(
+        graph, [&](std::uint32_t source, std::uint32_t target) { return query.run(source, target); },
+        [&](std::uint32_t) { return query.path(); }, sourceStep);
+}
+
+} // namespace
+
+TEST(ContractionHierarchyTest, MatchesDijkstraOnARoadGraph)
+{
+    expectSameDistances(makeRoadGraph(400, 12), 1, 37);
+}
+
+TEST(ContractionHierarchyTest, MatchesDijkstraOnAGridBuiltWithThreads)
+{
+    expectSameDistances(makeGridGraph(14, 14, 4), 3, 29);
+}
+
+TEST(ContractionHierarchyTest, MatchesDijkstraOnADirectedGraph)
+{
+    expectSameDistances(makeRandomGraph(150, 3, 21), 2, 11);
+}
@@ -0,0 +1,53 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "dijkstra.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using Graph = Dijkstra<>::GraphType;
+
+TEST(CsrDijkstraTest, MatchesTheMapDijkstra)
+{
+    for (unsigned seed = 1; seed <= 30; ++seed)
+    {
+        const Graph graph = randomLabelledGraph(seed, 20, 60);
+        const CsrGraph csr = buildCsrGraph(graph);
+        CsrDijkstra<> engine(csr.view());
+        for (char target = 'a'; target < 'a' + 20; ++target)
+        {
+            Dijkstra<BinaryHeap> reference(Point('a', 0.0f), Point(target, 0.0f), graph);
+            reference.initializeDistances();
+            reference.calculateDistances();
+            std::vector<char> expected = reference.reconstructPath();
+
+            engine.run(csr.idOf('a'), csr.idOf(target));
+            std::vector<char> path;
+            for (std::uint32_t node : engine.path(csr.idOf(target)))
+            {
+                path.push_back(csr.labels[node]);
+            }
+            EXPECT_EQ(path, expected) << "seed " << seed << ", target " << target;
+        }
+    }
+}
+
+TEST(CsrDijkstraTest, ReusedEngineAnswersLikeAFreshOne)
+{
+    const CsrGraph csr = randomCsrGraph(7, 300, 1200);
+    CsrDijkstra<> reused(csr.view());
+    for (std::uint32_t source = 0; source < 40; ++source)
+    {
+        reused.run(source);
+        CsrDijkstra<> fresh(csr.view());
+        fresh.run(source);
+        for (std::uint32_t node = 0; node < csr.nodeCount(); ++node)
+        {
+            ASSERT_EQ(reused.distance(node), fresh.distance(node)) << "source " << source << ", node " << node;
+            ASSERT_EQ(reused.predecessor(node), fresh.predecessor(node)) << "source " << source << ", node " << node;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "delta_stepping.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Runs delta-stepping from a few sources and compares every distance with Dijkstra, bit for bit.
+ */
+void expectSameDistances(const CsrGraph &graph, float delta, unsigned threads)
+{
+    DeltaStepping engine(graph.view(), delta, threads);
+    CsrDijkstra<> reference(graph.view());
+    for (std::uint32_t source = 0; source < graph.nodeCount(); source += graph.nodeCount() / 5)
+    {
+        engine.run(source);
+        reference.run(source);
+        EXPECT_EQ(engine.reachedCount(), reference.settledCount()) << "source " << source;
+        for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+        {
+            ASSERT_EQ(engine.distance(node), reference.distance(node)) << "source " << source << ", node " << node;
+            if (reference.distance(node) != INFINITY_VALUE)
+            {
+                std::vector<std::uint32_t> path = engine.path(node);
+                ASSERT_FALSE(path.empty());
+                EXPECT_EQ(path.front(), source);
+                EXPECT_EQ(path.back(), node);
+                EXPECT_NEAR(pathCost(graph.view(), path), reference.distance(node),
+                            sumTolerance(reference.distance(node)));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(DeltaSteppingTest, MatchesDijkstraWithTheDefaultDelta)
+{
+    expectSameDistances(makeRoadGraph(800, 17), 0.0f, 3);
+}
+
+TEST(DeltaSteppingTest, MatchesDijkstraForSmallAndLargeDeltas)
+{
+    const CsrGraph graph = makeGridGraph(20, 20, 2);
+    for (float delta : {0.5f, 3.0f, 1000.0f})
+    {
+        expectSameDistances(graph, delta, 2);
+    }
+}
+
+TEST(DeltaSteppingTest, MatchesDijkstraOnADirectedGraph)
+{
+    expectSameDistances(makeRandomGraph(500, 4, 6), 0.0f, 4);
+}
+
+TEST(DeltaSteppingTest, PredecessorsDoNotDependOnTheThreadCount)
+{
+    const CsrGraph graph = makeGridGraph(16, 16, 5, 3.0f);
+    DeltaStepping single(graph.view(), 0.0f, 1);
+    DeltaStepping parallel(graph.view(), 0.0f, 4);
+    single.run(7);
+    parallel.run(7);
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+    {
+        EXPECT_EQ(parallel.predecessor(node), single.predecessor(node)) << "node " << node;
+    }
+}
@@ -0,0 +1,98 @@
+#include "dijkstra.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+using Graph = Dijkstra<>::GraphType;
+
+/**
+ * @brief The six-node example graph of the Module 3 programs.
+ */
+Graph exampleGraph()
+{
+    return {{'A', {{'B', 4.0f}, {'C', 2.0f}}},
+            {'B', {{'A', 4.0f}, {'C', 1.0f}, {'D', 5.0f}}},
+            {'C', {{'A', 2.0f}, {'B', 1.0f}, {'D', 8.0f}, {'E', 10.0f}}},
+            {'D', {{'B', 5.0f}, {'C', 8.0f}, {'E', 2.0f}, {'F', 6.0f}}},
+            {'E', {{'C', 10.0f}, {'D', 2.0f}, {'F', 2.0f}}},
+            {'F', {{'D', 6.0f}, {'E', 2.0f}}}};
+}
+
+/**
+ * @brief Result of one search: the nodes in the order they were settled, and the path found.
+ */
+struct Run
+{
+    std::vector<std::uint32_t> settled;
+    std::vector<char> path;
+};
+
+template <typename Frontier>
+Run search(const Graph &graph, char start, char end)
+{
+    Dijkstra<Frontier, EventLogTrace<>> dijkstra(Point(start, 0.0f), Point(end, 0.0f), graph);
+    dijkstra.initializeDistances();
+    dijkstra.calculateDistances();
+    Run run;
+    const EventLogTrace<> &log = dijkstra.tracer();
+    for (std::size_t i = 0; i < log.size(); ++i)
+    {
+        if (log[i].kind == TraceEvent::ITERATION)
+        {
+            run.settled.push_back(log[i].node);
+        }
+    }
+    run.path = dijkstra.reconstructPath();
+    return run;
+}
+
+template <typename Frontier>
+class HeapFrontierTest : public ::testing::Test
+{
+};
+
+using HeapFrontiers = ::testing::Types<BinaryHeap, QuaternaryHeap, LazyHeap>;
+TYPED_TEST_SUITE(HeapFrontierTest, HeapFrontiers);
+
+} // namespace
+
+TYPED_TEST(HeapFrontierTest, SettlesLikeTheLinearScanOnTheExample)
+{
+    const Graph graph = exampleGraph();
+    Run reference = search<LinearScan>(graph, 'A', 'F');
+    Run heap = search<TypeParam>(graph, 'A', 'F');
+
+    EXPECT_EQ(heap.settled, reference.settled);
+    EXPECT_EQ(heap.path, reference.path);
+    EXPECT_EQ(reference.path, (std::vector<char>{'A', 'C', 'B', 'D', 'E', 'F'}));
+}
+
+TYPED_TEST(HeapFrontierTest, SettlesLikeTheLinearScanOnRandomGraphs)
+{
+    for (unsigned seed = 1; seed <= 40; ++seed)
+    {
+        const Graph graph = randomLabelledGraph(seed, 20, 60);
+        // '#' is not in the graph, so both searches settle every reachable node.
+        Run reference = search<LinearScan>(graph, 'a', '#');
+        Run heap = search<TypeParam>(graph, 'a', '#');
+        EXPECT_EQ(heap.settled, reference.settled) << "seed " << seed;
+
+        reference = search<LinearScan>(graph, 'a', 't');
+        heap = search<TypeParam>(graph, 'a', 't');
+        EXPECT_EQ(heap.path, reference.path) << "seed " << seed;
+    }
+}
+
+TEST(DijkstraTest, ReportsNoPathToAnUnreachableNode)
+{
+    Graph graph = exampleGraph();
+    graph['G'];
+    EXPECT_TRUE(search<BinaryHeap>(graph, 'A', 'G').path.empty());
+    EXPECT_TRUE(search<LinearScan>(graph, 'A', 'G').path.empty());
+}
@@ -0,0 +1,130 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "dynamic_sssp.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Compares the repaired tree with a fresh Dijkstra run on the current weights.
+ */
+void expectFreshTree(const DynamicShortestPaths &engine, std::uint32_t step)
+{
+    const CsrView current = engine.view();
+    CsrDijkstra<> reference(current);
+    reference.run(engine.source());
+    for (std::uint32_t node = 0; node < current.nodeCount; ++node)
+    {
+        ASSERT_EQ(engine.distance(node), reference.distance(node)) << "step " << step << ", node " << node;
+        if (reference.distance(node) != INFINITY_VALUE)
+        {
+            std::vector<std::uint32_t> path = engine.path(node);
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(path.front(), engine.source());
+            EXPECT_EQ(path.back(), node);
+            EXPECT_NEAR(pathCost(current, path), reference.distance(node), sumTolerance(reference.distance(node)));
+        }
+    }
+}
+
+} // namespace
+
+TEST(DynamicShortestPathsTest, StartsWithTheDijkstraTree)
+{
+    const CsrGraph graph = makeRoadGraph(500, 3);
+    DynamicShortestPaths engine(graph.view(), 7);
+    expectFreshTree(engine, 0);
+}
+
+TEST(DynamicShortestPathsTest, RandomUpdatesMatchAFreshRun)
+{
+    const CsrGraph graph = makeRoadGraph(400, 11);
+    DynamicShortestPaths engine(graph.view(), 0);
+    std::mt19937 random(5);
+    std::uniform_int_distribution<std::uint32_t> pickEdge(0, graph.view().edgeCount - 1);
+    std::uniform_real_distribution<float> factor(0.1f, 4.0f);
+    for (std::uint32_t step = 1; step <= 200; ++step)
+    {
+        std::uint32_t edge = pickEdge(random);
+        engine.updateEdge(edge, engine.weight(edge) * factor(random));
+        expectFreshTree(engine, step);
+        EXPECT_EQ(engine.version(), step);
+    }
+}
+
+TEST(DynamicShortestPathsTest, TreeEdgeIncreasesAreRepaired)
+{
+    // Always lengthen the tree edge into a node, the case that rebuilds a subtree.
+    const CsrGraph graph = makeGridGraph(15, 15, 4);
+    DynamicShortestPaths engine(graph.view(), 0);
+    CsrView view = engine.view();
+    for (std::uint32_t step = 1; step <= 60; ++step)
+    {
+        std::uint32_t node = (step * 37) % view.nodeCount;
+        std::uint32_t parent = engine.predecessor(node);
+        if (parent == NO_NODE)
+        {
+            continue;
+        }
+        for (std::uint32_t edge = view.firstEdge(parent); edge < view.lastEdge(parent); ++edge)
+        {
+            if (view.targets[edge] == node)
+            {
+                engine.updateEdge(edge, engine.weight(edge) + 25.0f);
+                break;
+            }
+        }
+        expectFreshTree(engine, step);
+    }
+}
+
+TEST(DynamicShortestPathsTest, RepairStaysLocal)
+{
+    // A chain 0 -> 1 -> ... -> 9 with a long shortcut 0 -> 9.
+    std::vector<Edge> edges;
+    for (std::uint32_t node = 0; node + 1 < 10; ++node)
+    {
+        edges.push_back({node, node + 1, 1.0f});
+    }
+    edges.push_back({0, 9, 100.0f});
+    const CsrGraph graph = buildCsrGraph(10, edges);
+    DynamicShortestPaths engine(graph.view(), 0);
+    EXPECT_EQ(engine.distance(9), 9.0f);
+
+    // Off the tree and getting longer: nothing to do.
+    ASSERT_TRUE(engine.updateWeight(0, 9, 200.0f));
+    EXPECT_EQ(engine.repairedCount(), 0u);
+
+    // The last chain edge only affects node 9.
+    ASSERT_TRUE(engine.updateWeight(8, 9, 3.0f));
+    EXPECT_EQ(engine.repairedCount(), 1u);
+    EXPECT_EQ(engine.distance(9), 11.0f);
+
+    // Now the shortcut wins.
+    ASSERT_TRUE(engine.updateWeight(0, 9, 5.0f));
+    EXPECT_EQ(engine.distance(9), 5.0f);
+    EXPECT_EQ(engine.predecessor(9), 0u);
+    EXPECT_EQ(engine.version(), 3u);
+
+    EXPECT_FALSE(engine.updateWeight(9, 0, 1.0f));
+    EXPECT_EQ(engine.version(), 3u);
+}
+
+TEST(DynamicShortestPathsTest, UnreachableNodesStayUnreachable)
+{
+    const CsrGraph graph = buildCsrGraph(4, {{0, 1, 1.0f}, {2, 3, 1.0f}});
+    DynamicShortestPaths engine(graph.view(), 0);
+    ASSERT_TRUE(engine.updateWeight(2, 3, 0.5f));
+    EXPECT_EQ(engine.distance(3), INFINITY_VALUE);
+    EXPECT_TRUE(engine.path(3).empty());
+    ASSERT_TRUE(engine.updateWeight(0, 1, 4.0f));
+    EXPECT_EQ(engine.distance(1), 4.0f);
+}
@@ -0,0 +1,153 @@
+#include "csr_graph.hpp"
+#include "edge_list_parser.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Edges read from text through a temporary file, as readEdgeList() sees a real one.
+ */
+std::vector<Edge> parse(const std::string &text, const EdgeListOptions &options = EdgeListOptions())
+{
+    std::FILE *file = std::tmpfile();
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::rewind(file);
+    try
+    {
+        std::vector<Edge> edges = readEdgeList(file, options);
+        std::fclose(file);
+        return edges;
+    }
+    catch (...)
+    {
+        std::fclose(file);
+        throw;
+    }
+}
+
+/**
+ * @brief Message of the runtime_error thrown by parse(), or "" if it succeeds.
+ */
+std::string parseError(const std::string &text, const EdgeListOptions &options = EdgeListOptions())
+{
+    try
+    {
+        parse(text, options);
+    }
+    catch (const std::runtime_error &error)
+    {
+        return error.what();
+    }
+    return "";
+}
+
+std::string writeTemporary(const char *name, const std::string &text)
+{
+    std::string path = ::testing::TempDir() + name;
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+    return path;
+}
+
+} // namespace
+
+TEST(EdgeListParserTest, ReadsFieldsBlanksCommentsAndLineEnds)
+{
+    std::vector<Edge> edges = parse("# from,to,weight\n0,1,2.5\r\n  3 ,\t4, 1e1 \n\n7,0,0\n9,9,0.125");
+    ASSERT_EQ(edges.size(), 4u);
+    EXPECT_EQ(edges[0].from, 0u);
+    EXPECT_EQ(edges[0].to, 1u);
+    EXPECT_EQ(edges[0].weight, 2.5f);
+    EXPECT_EQ(edges[1].from, 3u);
+    EXPECT_EQ(edges[1].to, 4u);
+    EXPECT_EQ(edges[1].weight, 10.0f);
+    EXPECT_EQ(edges[2].weight, 0.0f);
+    EXPECT_EQ(edges[3].to, 9u);
+    EXPECT_EQ(edges[3].weight, 0.125f);
+}
+
+TEST(EdgeListParserTest, OtherSeparator)
+{
+    EdgeListOptions options;
+    options.separator = ' ';
+    std::vector<Edge> edges = parse("1 2 3\n4  5\t 6\n", options);
+    ASSERT_EQ(edges.size(), 2u);
+    EXPECT_EQ(edges[1].from, 4u);
+    EXPECT_EQ(edges[1].to, 5u);
+    EXPECT_EQ(edges[1].weight, 6.0f);
+    EXPECT_EQ(parseError("1 2\n", options), "malformed edge list line 1");
+}
+
+TEST(EdgeListParserTest, SmallChunksAndThreadsKeepTheFileOrder)
+{
+    std::string text;
+    for (std::uint32_t i = 0; i < 3000; ++i)
+    {
+        text += std::to_string(i) + "," + std::to_string((i * 7) % 3000) + "," + std::to_string(i % 13) + "\n";
+    }
+    const std::vector<Edge> expected = parse(text);
+    ASSERT_EQ(expected.size(), 3000u);
+
+    EdgeListOptions options;
+    options.threads = 3;
+    options.chunkSize = 100; // Lines straddle almost every chunk boundary.
+    std::vector<Edge> edges = parse(text, options);
+    ASSERT_EQ(edges.size(), expected.size());
+    for (std::size_t i = 0; i < edges.size(); ++i)
+    {
+        ASSERT_EQ(edges[i].from, expected[i].from) << "edge " << i;
+        ASSERT_EQ(edges[i].to, expected[i].to) << "edge " << i;
+        ASSERT_EQ(edges[i].weight, expected[i].weight) << "edge " << i;
+    }
+}
+
+TEST(EdgeListParserTest, ReportsTheLineOfAMalformedEntry)
+{
+    EXPECT_EQ(parseError("0,1,1\n1,2\n"), "malformed edge list line 2");
+    EXPECT_EQ(parseError("0,1,1\n# note\n\n1,x,2\n"), "malformed edge list line 4");
+    EXPECT_EQ(parseError("0,1,-3\n"), "malformed edge list line 1");
+    EXPECT_EQ(parseError("0,1,nan\n"), "malformed edge list line 1");
+    EXPECT_EQ(parseError("4294967295,1,1\n"), "malformed edge list line 1"); // NO_NODE.
+    EXPECT_EQ(parseError("0,1,1,4\n"), "malformed edge list line 1");
+
+    EdgeListOptions options;
+    options.threads = 4;
+    options.chunkSize = 8;
+    EXPECT_EQ(parseError("0,1,1\n1,2,2\n2,3,3\n3;4,4\n4,5,5\n", options), "malformed edge list line 4");
+}
+
+TEST(EdgeListParserTest, LoadsAGraphSizedByTheLargestId)
+{
+    const std::string path = writeTemporary("edges.csv", "0,1,1\n1,5,2\n");
+    CsrGraph graph = loadEdgeList(path);
+    EXPECT_EQ(graph.nodeCount(), 6u);
+    EXPECT_EQ(graph.edgeCount(), 2u);
+    std::remove(path.c_str());
+}
+
+TEST(EdgeListParserTest, RefusesIdsBeyondTheNodeLimit)
+{
+    const std::string path = writeTemporary("stray_id.csv", "0,1,1\n4294967294,0,1\n");
+    EXPECT_THROW(loadEdgeList(path), std::runtime_error);
+
+    EdgeListOptions options;
+    options.maxNodeCount = 100;
+    const std::string small = writeTemporary("limit.csv", "0,99,1\n");
+    EXPECT_EQ(loadEdgeList(small, options).nodeCount(), 100u);
+    const std::string over = writeTemporary("over_limit.csv", "0,100,1\n");
+    EXPECT_THROW(loadEdgeList(over, options), std::runtime_error);
+
+    EXPECT_THROW(loadEdgeList(::testing::TempDir() + "no_such_file.csv"), std::runtime_error);
+    std::remove(path.c_str());
+    std::remove(small.c_str());
+    std::remove(over.c_str());
+}
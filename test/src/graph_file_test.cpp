@@ -0,0 +1,140 @@
+#include "csr_graph.hpp"
+#include "graph_file.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::string temporaryPath(const char *name)
+{
+    return ::testing::TempDir() + name;
+}
+
+/**
+ * @brief Overwrites size bytes of a file at the given position.
+ */
+void patchFile(const std::string &path, std::uint64_t at, const void *data, std::size_t size)
+{
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(at));
+    file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+}
+
+GraphFileHeader readHeader(const std::string &path)
+{
+    GraphFileHeader header = {};
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    return header;
+}
+
+} // namespace
+
+TEST(GraphFileTest, RoundTripKeepsEveryArray)
+{
+    CsrGraph graph = makeGridGraph(9, 7, 3);
+    graph.labels.assign(graph.nodeCount(), 'x');
+    graph.labels[5] = 'F';
+    const std::string path = temporaryPath("round_trip.graph");
+    writeGraphFile(path, graph);
+
+    MappedGraph mapped(path);
+    EXPECT_TRUE(mapped.verifyChecksum());
+    EXPECT_TRUE(mapped.validate());
+    ASSERT_EQ(mapped.nodeCount(), graph.nodeCount());
+    ASSERT_EQ(mapped.edgeCount(), graph.edgeCount());
+    CsrView view = mapped.view();
+    EXPECT_EQ(std::vector<std::uint32_t>(view.offsets, view.offsets + view.nodeCount + 1), graph.offsets);
+    EXPECT_EQ(std::vector<std::uint32_t>(view.targets, view.targets + view.edgeCount), graph.targets);
+    EXPECT_EQ(std::vector<float>(view.weights, view.weights + view.edgeCount), graph.weights);
+    ASSERT_NE(view.coordinates, nullptr);
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+    {
+        EXPECT_EQ(view.coordinates[node].x, graph.coordinates[node].x);
+        EXPECT_EQ(view.coordinates[node].y, graph.coordinates[node].y);
+    }
+    ASSERT_NE(mapped.labels(), nullptr);
+    EXPECT_EQ(std::string(mapped.labels(), graph.nodeCount()), std::string(graph.labels.begin(), graph.labels.end()));
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, EmptyGraphRoundTrips)
+{
+    const CsrGraph graph = buildCsrGraph(0, {});
+    const std::string path = temporaryPath("empty.graph");
+    writeGraphFile(path, graph);
+    MappedGraph mapped(path);
+    EXPECT_EQ(mapped.nodeCount(), 0u);
+    EXPECT_TRUE(mapped.verifyChecksum());
+    EXPECT_TRUE(mapped.validate());
+    EXPECT_EQ(mapped.labels(), nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RejectsABrokenHeader)
+{
+    const CsrGraph graph = makeRandomGraph(50, 3, 1);
+    const std::string path = temporaryPath("broken_header.graph");
+    writeGraphFile(path, graph);
+    const GraphFileHeader header = readHeader(path);
+
+    // Last offset no longer equal to edgeCount.
+    const std::uint32_t wrongEnd = graph.edgeCount() + 1;
+    patchFile(path, header.offsetsAt + std::uint64_t(graph.nodeCount()) * 4, &wrongEnd, sizeof(wrongEnd));
+    EXPECT_THROW(MappedGraph mapped(path), std::runtime_error);
+
+    // Edge count pointing past the end of the file.
+    writeGraphFile(path, graph);
+    const std::uint32_t hugeCount = 0x40000000u;
+    patchFile(path, offsetof(GraphFileHeader, edgeCount), &hugeCount, sizeof(hugeCount));
+    EXPECT_THROW(MappedGraph mapped(path), std::runtime_error);
+
+    EXPECT_THROW(MappedGraph mapped(temporaryPath("missing.graph")), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, ValidateCatchesWhatTheHeaderCheckCannotSee)
+{
+    const CsrGraph graph = makeRandomGraph(50, 3, 2);
+    const std::string path = temporaryPath("broken_arrays.graph");
+    const GraphFileHeader header = [&]
+    {
+        writeGraphFile(path, graph);
+        return readHeader(path);
+    }();
+
+    const std::uint32_t outside = graph.nodeCount();
+    patchFile(path, header.targetsAt + 4 * 10, &outside, sizeof(outside));
+    {
+        MappedGraph mapped(path);
+        EXPECT_FALSE(mapped.verifyChecksum());
+        EXPECT_FALSE(mapped.validate());
+    }
+
+    writeGraphFile(path, graph);
+    const std::uint32_t backwards = graph.offsets[20] + 1;
+    patchFile(path, header.offsetsAt + 4 * 19, &backwards, sizeof(backwards));
+    {
+        MappedGraph mapped(path);
+        EXPECT_FALSE(mapped.validate());
+    }
+
+    writeGraphFile(path, graph);
+    const float negative = -1.0f;
+    patchFile(path, header.weightsAt + 4 * 7, &negative, sizeof(negative));
+    {
+        MappedGraph mapped(path);
+        EXPECT_FALSE(mapped.validate());
+    }
+    std::remove(path.c_str());
+}
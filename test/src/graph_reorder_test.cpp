@@ -0,0 +1,153 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "graph_reorder.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+
+const NodeOrder ORDERS[] = {NodeOrder::Bfs, NodeOrder::ReverseCuthillMcKee, NodeOrder::Hilbert};
+
+/**
+ * @brief Every edge of g as (from, to, weight), sorted.
+ */
+std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> edgeList(CsrView g)
+{
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> result;
+    for (std::uint32_t node = 0; node < g.nodeCount; ++node)
+    {
+        for (std::uint32_t edge = g.firstEdge(node); edge < g.lastEdge(node); ++edge)
+        {
+            result.emplace_back(node, g.targets[edge], g.weights[edge]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(GraphReorderTest, IdMapsAreInversePermutations)
+{
+    const CsrGraph graph = makeRoadGraph(700, 5);
+    for (NodeOrder order : ORDERS)
+    {
+        ReorderedGraph reordered = reorderGraph(graph, order);
+        ASSERT_EQ(reordered.toExternal.size(), graph.nodeCount());
+        ASSERT_EQ(reordered.toInternal.size(), graph.nodeCount());
+        for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+        {
+            ASSERT_EQ(reordered.external(reordered.internal(node)), node);
+            ASSERT_EQ(reordered.internal(reordered.external(node)), node);
+            EXPECT_EQ(reordered.graph.coordinates[reordered.internal(node)].x, graph.coordinates[node].x);
+        }
+        EXPECT_EQ(reordered.internal(NO_NODE), NO_NODE);
+    }
+}
+
+TEST(GraphReorderTest, EdgesSurviveTranslation)
+{
+    const CsrGraph graph = makeRoadGraph(500, 8);
+    const auto expected = edgeList(graph.view());
+    for (NodeOrder order : ORDERS)
+    {
+        ReorderedGraph reordered = reorderGraph(graph, order);
+        CsrView view = reordered.graph.view();
+        std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> translated;
+        for (std::uint32_t node = 0; node < view.nodeCount; ++node)
+        {
+            for (std::uint32_t edge = view.firstEdge(node); edge < view.lastEdge(node); ++edge)
+            {
+                if (edge > view.firstEdge(node))
+                {
+                    EXPECT_LE(view.targets[edge - 1], view.targets[edge]); // Rows are sorted by target.
+                }
+                translated.emplace_back(reordered.external(node), reordered.external(view.targets[edge]),
+                                        view.weights[edge]);
+            }
+        }
+        std::sort(translated.begin(), translated.end());
+        EXPECT_EQ(translated, expected);
+    }
+}
+
+TEST(GraphReorderTest, RenumberedSearchAnswersInExternalIds)
+{
+    const CsrGraph graph = makeRoadGraph(600, 14);
+    CsrDijkstra<> reference(graph.view());
+    for (NodeOrder order : ORDERS)
+    {
+        ReorderedGraph reordered = reorderGraph(graph, order);
+        RenumberedSearch<> search(reordered);
+        for (std::uint32_t source : {0u, 299u, 598u})
+        {
+            reference.run(source);
+            search.run(source);
+            EXPECT_EQ(search.settledCount(), reference.settledCount());
+            for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+            {
+                ASSERT_EQ(search.distance(node), reference.distance(node)) << "source " << source << ", node " << node;
+                if (reference.distance(node) == INFINITY_VALUE)
+                {
+                    EXPECT_TRUE(search.path(node).empty());
+                    continue;
+                }
+                std::vector<std::uint32_t> path = search.path(node);
+                ASSERT_FALSE(path.empty());
+                EXPECT_EQ(path.front(), source);
+                EXPECT_EQ(path.back(), node);
+                EXPECT_NEAR(pathCost(graph.view(), path), reference.distance(node),
+                            sumTolerance(reference.distance(node)));
+                if (path.size() > 1)
+                {
+                    EXPECT_EQ(search.predecessor(node), path[path.size() - 2]);
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphReorderTest, ShortBuffersAreLeftUntouched)
+{
+    const CsrGraph graph = makeGridGraph(12, 12, 2);
+    ReorderedGraph reordered = reorderGraph(graph, NodeOrder::ReverseCuthillMcKee);
+    RenumberedSearch<> search(reordered);
+    search.run(0, 143);
+    std::vector<std::uint32_t> expected = search.path(143);
+    ASSERT_GT(expected.size(), 3u);
+
+    std::vector<std::uint32_t> buffer(3, NO_NODE);
+    EXPECT_EQ(search.pathInto(143, buffer.data(), buffer.size()), expected.size());
+    EXPECT_EQ(buffer, std::vector<std::uint32_t>(3, NO_NODE));
+
+    buffer.assign(expected.size(), NO_NODE);
+    EXPECT_EQ(search.pathInto(143, buffer.data(), buffer.size()), expected.size());
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(GraphReorderTest, LabelsFollowTheirNodes)
+{
+    const CsrGraph graph = buildCsrGraph(std::map<char, std::vector<Point>>{
+        {'A', {{'B', 4.0f}, {'C', 2.0f}}}, {'B', {{'D', 5.0f}}}, {'C', {{'B', 1.0f}}}, {'D', {}}});
+    ReorderedGraph reordered = reorderGraph(graph, NodeOrder::Bfs);
+    for (char label : {'A', 'B', 'C', 'D'})
+    {
+        EXPECT_EQ(reordered.external(reordered.graph.idOf(label)), graph.idOf(label));
+    }
+}
+
+TEST(GraphReorderTest, HilbertNeedsCoordinates)
+{
+    const CsrGraph graph = buildCsrGraph(3, {{0, 1, 1.0f}, {1, 2, 1.0f}});
+    EXPECT_THROW(reorderGraph(graph, NodeOrder::Hilbert), std::invalid_argument);
+}
@@ -0,0 +1,81 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+TEST(IsochroneTest, BallIsEveryNodeWithinTheBudget)
+{
+    const CsrGraph graph = makeRoadGraph(2000, 13);
+    CsrDijkstra<> full(graph.view());
+    CsrDijkstra<> bounded(graph.view());
+    std::vector<ReachedNode> ball;
+    for (std::uint32_t source : {0u, 777u, 1999u})
+    {
+        full.run(source);
+        for (float budget : {0.0f, 5.0f, 40.0f, 1e9f})
+        {
+            bounded.runWithin(source, budget, ball);
+
+            std::vector<std::uint8_t> inBall(graph.nodeCount(), 0);
+            float previous = 0.0f;
+            for (const ReachedNode &reached : ball)
+            {
+                EXPECT_EQ(reached.distance, full.distance(reached.node)) << "node " << reached.node;
+                EXPECT_LE(reached.distance, budget);
+                EXPECT_GE(reached.distance, previous); // Settled by non-decreasing distance.
+                previous = reached.distance;
+                EXPECT_EQ(bounded.distance(reached.node), reached.distance);
+                EXPECT_EQ(bounded.path(reached.node), full.path(reached.node)) << "node " << reached.node;
+                inBall[reached.node] = 1;
+            }
+
+            std::uint32_t within = 0;
+            for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+            {
+                bool close = full.distance(node) <= budget;
+                within += close ? 1u : 0u;
+                EXPECT_EQ(inBall[node] == 1, close) << "source " << source << ", budget " << budget << ", node "
+                                                    << node;
+            }
+            EXPECT_EQ(bounded.settledCount(), within);
+            EXPECT_EQ(ball.size(), within);
+        }
+    }
+}
+
+TEST(IsochroneTest, SmallBudgetsOnlyTouchTheirBall)
+{
+    const CsrGraph graph = makeGridGraph(200, 200, 8);
+    CsrDijkstra<> engine(graph.view());
+    std::vector<ReachedNode> ball;
+    engine.run(0); // A full run first: the next ball must not inherit anything from it.
+    std::uint32_t count = engine.runWithin(20100, 6.0f, ball);
+    EXPECT_GT(count, 0u);
+    EXPECT_LT(count, 100u);
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+    {
+        EXPECT_EQ(engine.context().isSettled(node), node == 20100 || engine.distance(node) <= 6.0f);
+    }
+}
+
+TEST(IsochroneTest, DistanceOnlyEnginesGiveTheSameBall)
+{
+    const CsrGraph graph = makeRoadGraph(1000, 4);
+    CsrDijkstra<> withPaths(graph.view());
+    DistanceOnlyDijkstra<> distanceOnly(graph.view());
+    std::vector<ReachedNode> expected;
+    std::vector<ReachedNode> ball;
+    withPaths.runWithin(10, 25.0f, expected);
+    distanceOnly.runWithin(10, 25.0f, ball);
+    ASSERT_EQ(ball.size(), expected.size());
+    for (std::size_t i = 0; i < ball.size(); ++i)
+    {
+        EXPECT_EQ(ball[i].node, expected[i].node);
+        EXPECT_EQ(ball[i].distance, expected[i].distance);
+    }
+}
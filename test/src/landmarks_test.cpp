@@ -0,0 +1,159 @@
+#include "astar.hpp"
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "landmarks.hpp"
+#include "synthetic_graphs.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Checks lowerBound(v, t) <= d(v, t) for every pair, and that it is tight from a landmark.
+ */
+void expectAdmissible(const CsrGraph &graph, const LandmarkTable &table)
+{
+    CsrDijkstra<> reference(graph.view());
+    std::vector<std::uint8_t> isLandmark(graph.nodeCount(), 0);
+    for (std::uint32_t landmark : table.landmarks)
+    {
+        isLandmark[landmark] = 1;
+    }
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+    {
+        reference.run(node);
+        for (std::uint32_t target = 0; target < graph.nodeCount(); ++target)
+        {
+            float distance = reference.distance(target);
+            float bound = table.lowerBound(node, target);
+            ASSERT_GE(bound, 0.0f);
+            if (distance == INFINITY_VALUE)
+            {
+                continue;
+            }
+            ASSERT_LE(bound, distance + sumTolerance(distance)) << node << " -> " << target;
+            if (isLandmark[node])
+            {
+                EXPECT_NEAR(bound, distance, sumTolerance(distance)) << node << " -> " << target;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(LandmarkTableTest, BoundsAreAdmissibleWithBothStrategies)
+{
+    const CsrGraph graph = makeRandomGraph(250, 3, 12); // Directed, with unreachable pairs.
+    for (LandmarkStrategy strategy : {LandmarkStrategy::Farthest, LandmarkStrategy::Avoid})
+    {
+        LandmarkOptions options;
+        options.count = 6;
+        options.strategy = strategy;
+        options.threads = 2;
+        LandmarkTable table = LandmarkTable::build(graph.view(), options);
+        ASSERT_EQ(table.landmarkCount(), 6u);
+        ASSERT_EQ(table.nodeCount(), graph.nodeCount());
+        expectAdmissible(graph, table);
+    }
+}
+
+TEST(LandmarkTableTest, AltQueriesMatchDijkstraAndSettleLess)
+{
+    const CsrGraph graph = makeRoadGraph(1500, 2);
+    LandmarkTable table = LandmarkTable::build(graph.view());
+    AStar<LandmarkHeuristic> alt(graph.view(), LandmarkHeuristic(table));
+    CsrDijkstra<> reference(graph.view());
+    std::uint64_t altSettled = 0;
+    std::uint64_t dijkstraSettled = 0;
+    for (std::uint32_t query = 0; query < 40; ++query)
+    {
+        std::uint32_t source = (query * 389) % graph.nodeCount();
+        std::uint32_t target = (query * 977 + 500) % graph.nodeCount();
+        reference.run(source, target);
+        float found = alt.run(source, target);
+        ASSERT_FLOAT_EQ(found, reference.distance(target)) << source << " -> " << target;
+        altSettled += alt.settledCount();
+        dijkstraSettled += reference.settledCount();
+    }
+    EXPECT_LT(altSettled * 2, dijkstraSettled);
+}
+
+TEST(LandmarkTableTest, SavedTablesLoadOnlyForTheirGraph)
+{
+    const CsrGraph graph = makeGridGraph(20, 20, 5);
+    LandmarkOptions options;
+    options.count = 4;
+    LandmarkTable table = LandmarkTable::build(graph.view(), options);
+    const std::string path = ::testing::TempDir() + "landmarks_test.lmk";
+    table.save(path);
+
+    LandmarkTable loaded = LandmarkTable::load(path, graph.view());
+    EXPECT_EQ(loaded.landmarks, table.landmarks);
+    EXPECT_EQ(loaded.fromLandmark, table.fromLandmark);
+    EXPECT_EQ(loaded.toLandmark, table.toLandmark);
+
+    const CsrGraph other = makeGridGraph(20, 20, 6);
+    EXPECT_THROW(LandmarkTable::load(path, other.view()), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(LandmarkTableTest, DamagedFilesAreRefused)
+{
+    const CsrGraph graph = makeGridGraph(10, 10, 1);
+    LandmarkOptions options;
+    options.count = 3;
+    LandmarkTable table = LandmarkTable::build(graph.view(), options);
+    const std::string path = ::testing::TempDir() + "landmarks_damaged.lmk";
+    table.save(path);
+    std::vector<char> bytes;
+    {
+        // One read into a buffer sized from the file length (stream iterators trip -Wnull-dereference).
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        ASSERT_TRUE(in.good());
+        std::streamoff size = in.tellg();
+        ASSERT_GT(size, static_cast<std::streamoff>(sizeof(LandmarkFileHeader)));
+        bytes.resize(static_cast<std::size_t>(size));
+        in.seekg(0);
+        ASSERT_TRUE(in.read(bytes.data(), size).good());
+    }
+    auto write = [&](const std::vector<char> &content)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    };
+
+    // Truncated payload.
+    write(std::vector<char>(bytes.begin(), bytes.end() - 4));
+    EXPECT_THROW(LandmarkTable::load(path, graph.view()), std::runtime_error);
+
+    // A landmark count that does not match the file size is refused before anything is allocated.
+    std::vector<char> huge = bytes;
+    LandmarkFileHeader header;
+    std::memcpy(&header, huge.data(), sizeof(header));
+    header.landmarkCount = 0x40000000u;
+    std::memcpy(huge.data(), &header, sizeof(header));
+    write(huge);
+    EXPECT_THROW(LandmarkTable::load(path, graph.view()), std::runtime_error);
+
+    // One flipped payload bit fails the checksum.
+    std::vector<char> flipped = bytes;
+    flipped[sizeof(LandmarkFileHeader) + 5] ^= 1;
+    write(flipped);
+    EXPECT_THROW(LandmarkTable::load(path, graph.view()), std::runtime_error);
+
+    write(bytes);
+    EXPECT_NO_THROW(LandmarkTable::load(path, graph.view()));
+    std::remove(path.c_str());
+}
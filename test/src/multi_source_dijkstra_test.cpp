@@ -0,0 +1,77 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "multi_source_dijkstra.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST(MultiSourceDijkstraTest, MatchesTheNearestOfSingleSourceRuns)
+{
+    const CsrGraph graph = makeRoadGraph(600, 21);
+    const std::vector<std::uint32_t> sources = {3, 150, 151, 420, 599};
+    MultiSourceDijkstra<> engine(graph.view());
+    engine.run(sources);
+
+    std::vector<std::vector<float>> single;
+    CsrDijkstra<> reference(graph.view());
+    for (std::uint32_t source : sources)
+    {
+        reference.run(source);
+        single.emplace_back();
+        for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+        {
+            single.back().push_back(reference.distance(node));
+        }
+    }
+
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+    {
+        float nearest = INFINITY_VALUE;
+        for (const std::vector<float> &distances : single)
+        {
+            nearest = std::min(nearest, distances[node]);
+        }
+        ASSERT_EQ(engine.distance(node), nearest) << "node " << node;
+        if (nearest == INFINITY_VALUE)
+        {
+            EXPECT_EQ(engine.nearestSource(node), NO_NODE);
+            continue;
+        }
+        std::uint32_t index = engine.sourceIndex(node);
+        ASSERT_LT(index, sources.size());
+        EXPECT_EQ(engine.nearestSource(node), sources[index]);
+        EXPECT_EQ(single[index][node], nearest) << "node " << node;
+
+        std::vector<std::uint32_t> path = engine.path(node);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), sources[index]);
+        EXPECT_EQ(path.back(), node);
+    }
+}
+
+TEST(MultiSourceDijkstraTest, SourcesAreTheirOwnNearest)
+{
+    const CsrGraph graph = makeGridGraph(12, 12, 6);
+    MultiSourceDijkstra<QuaternaryHeap> engine(graph.view());
+    engine.run({10, 70, 10});
+    EXPECT_EQ(engine.distance(10), 0.0f);
+    EXPECT_EQ(engine.sourceIndex(10), 0u); // A repeated source keeps its first position.
+    EXPECT_EQ(engine.sourceIndex(70), 1u);
+    EXPECT_EQ(engine.settledCount(), graph.nodeCount());
+}
+
+TEST(MultiSourceDijkstraTest, NoSourcesReachNothing)
+{
+    const CsrGraph graph = makeGridGraph(4, 4, 1);
+    MultiSourceDijkstra<> engine(graph.view());
+    engine.run({5});
+    engine.run({});
+    EXPECT_EQ(engine.settledCount(), 0u);
+    EXPECT_EQ(engine.distance(5), INFINITY_VALUE);
+    EXPECT_EQ(engine.nearestSource(5), NO_NODE);
+    EXPECT_TRUE(engine.path(5).empty());
+}
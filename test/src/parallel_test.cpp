@@ -0,0 +1,68 @@
+#include "parallel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+TEST(ThreadPoolTest, CoversEveryItemOnceAcrossManyLoops)
+{
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.threadCount(), 4u);
+    std::vector<std::atomic<unsigned>> hits(1000);
+    for (unsigned loop = 0; loop < 500; ++loop)
+    {
+        std::size_t count = loop % 7 == 0 ? 0 : (loop * 37) % hits.size();
+        std::atomic<bool> badWorker(false);
+        pool.parallelFor(count, 8,
+                         [&](unsigned worker, std::size_t begin, std::size_t end)
+                         {
+                             if (worker >= 4 || begin >= end || end > count)
+                             {
+                                 badWorker = true;
+                             }
+                             for (std::size_t i = begin; i < end; ++i)
+                             {
+                                 hits[i].fetch_add(1, std::memory_order_relaxed);
+                             }
+                         });
+        ASSERT_FALSE(badWorker) << "loop " << loop;
+        for (std::size_t i = 0; i < hits.size(); ++i)
+        {
+            ASSERT_EQ(hits[i].exchange(0), i < count ? 1u : 0u) << "loop " << loop << ", item " << i;
+        }
+    }
+}
+
+TEST(ThreadPoolTest, SingleChunkRunsOnTheCaller)
+{
+    ThreadPool pool(3);
+    unsigned calls = 0;
+    pool.parallelFor(10, 64,
+                     [&](unsigned worker, std::size_t begin, std::size_t end)
+                     {
+                         EXPECT_EQ(worker, 0u);
+                         EXPECT_EQ(begin, 0u);
+                         EXPECT_EQ(end, 10u);
+                         calls++;
+                     });
+    EXPECT_EQ(calls, 1u);
+}
+
+TEST(ThreadPoolTest, FreeParallelForCoversEveryItem)
+{
+    std::vector<std::atomic<unsigned>> hits(777);
+    parallelFor(hits.size(), 3, 10,
+                [&](unsigned, std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        hits[i]++;
+                    }
+                });
+    for (const std::atomic<unsigned> &hit : hits)
+    {
+        EXPECT_EQ(hit.load(), 1u);
+    }
+}
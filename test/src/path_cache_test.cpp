@@ -0,0 +1,137 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "dynamic_sssp.hpp"
+#include "path_cache.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+QueryResult answer(float distance, std::vector<std::uint32_t> path)
+{
+    QueryResult result;
+    result.distance = distance;
+    result.path = std::move(path);
+    return result;
+}
+
+} // namespace
+
+TEST(PathCacheTest, StoredPairsAreFound)
+{
+    PathCache cache;
+    QueryResult result;
+    EXPECT_FALSE(cache.lookup(1, 4, 0, result));
+    cache.storePath(1, 4, 0, answer(7.5f, {1, 2, 4}));
+    ASSERT_TRUE(cache.lookup(1, 4, 0, result));
+    EXPECT_EQ(result.distance, 7.5f);
+    EXPECT_EQ(result.path, (std::vector<std::uint32_t>{1, 2, 4}));
+    EXPECT_EQ(result.settled, 0u);
+    EXPECT_FALSE(cache.lookup(4, 1, 0, result));
+
+    PathCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_GT(stats.bytes, 0u);
+}
+
+TEST(PathCacheTest, ANewVersionInvalidatesEverything)
+{
+    PathCache cache;
+    cache.storePath(1, 4, 3, answer(7.5f, {1, 2, 4}));
+    QueryResult result;
+    EXPECT_FALSE(cache.lookup(1, 4, 4, result));
+    EXPECT_EQ(cache.stats().invalidations, 1u);
+
+    // Answers computed on the old graph are not taken any more, nor returned for the old version.
+    cache.storePath(1, 4, 3, answer(7.5f, {1, 2, 4}));
+    EXPECT_FALSE(cache.lookup(1, 4, 4, result));
+    EXPECT_FALSE(cache.lookup(1, 4, 3, result));
+    cache.storePath(1, 4, 4, answer(9.0f, {1, 4}));
+    ASSERT_TRUE(cache.lookup(1, 4, 4, result));
+    EXPECT_EQ(result.distance, 9.0f);
+}
+
+TEST(PathCacheTest, OlderVersionsDoNotSeeNewerAnswers)
+{
+    PathCache cache;
+    cache.storePath(1, 4, 5, answer(9.0f, {1, 4}));
+    QueryResult result;
+    ASSERT_TRUE(cache.lookup(1, 4, 5, result));
+
+    // A caller still on version 4 must search its own graph, not get the answer of version 5.
+    result = QueryResult();
+    EXPECT_FALSE(cache.lookup(1, 4, 4, result));
+    EXPECT_EQ(result.distance, INFINITY_VALUE);
+    EXPECT_TRUE(result.path.empty());
+    ASSERT_TRUE(cache.lookup(1, 4, 5, result)); // The newer entry is still there.
+    EXPECT_EQ(result.distance, 9.0f);
+}
+
+TEST(PathCacheTest, HotSourcesAreAnsweredFromTheirTree)
+{
+    const CsrGraph graph = makeGridGraph(10, 10, 3);
+    PathCacheOptions options;
+    options.hotSourceThreshold = 2;
+    PathCache cache(options);
+    CsrDijkstra<> engine(graph.view());
+    CsrDijkstra<> reference(graph.view());
+    reference.run(0);
+    for (std::uint32_t target = 1; target < graph.nodeCount(); ++target)
+    {
+        QueryResult result = cachedQuery(cache, engine, {0, target}, 0);
+        ASSERT_EQ(result.distance, reference.distance(target)) << "target " << target;
+        EXPECT_EQ(result.path, reference.path(target)) << "target " << target;
+    }
+    // Two misses made the source hot; every later target came from the tree.
+    PathCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.treeHits, graph.nodeCount() - 3);
+
+    QueryResult result;
+    EXPECT_FALSE(cache.lookup(0, 50, 1, result)); // The tree belongs to version 0.
+}
+
+TEST(PathCacheTest, WeightUpdatesInvalidateCachedAnswers)
+{
+    const CsrGraph graph = makeGridGraph(8, 8, 9);
+    DynamicShortestPaths tree(graph.view(), 0);
+    PathCache cache;
+    CsrDijkstra<> engine(tree.view());
+    const std::uint32_t target = graph.nodeCount() - 1;
+
+    QueryResult before = cachedQuery(cache, engine, {0, target}, tree.version());
+    EXPECT_EQ(before.distance, tree.distance(target));
+
+    // Make the first edge of the cached path much longer.
+    ASSERT_GE(before.path.size(), 2u);
+    ASSERT_TRUE(tree.updateWeight(before.path[0], before.path[1], 1000.0f));
+    QueryResult after = cachedQuery(cache, engine, {0, target}, tree.version());
+    EXPECT_EQ(after.distance, tree.distance(target));
+    EXPECT_GT(after.settled, 0u);
+    EXPECT_NE(after.distance, before.distance);
+}
+
+TEST(PathCacheTest, StaysWithinItsBudget)
+{
+    PathCacheOptions options;
+    options.pathBytes = 4096;
+    options.shards = 2;
+    PathCache cache(options);
+    for (std::uint32_t target = 0; target < 500; ++target)
+    {
+        cache.storePath(0, target, 0, answer(1.0f, std::vector<std::uint32_t>(8, target)));
+    }
+    PathCacheStats stats = cache.stats();
+    EXPECT_LE(stats.bytes, options.pathBytes);
+    EXPECT_GT(stats.evictions, 0u);
+
+    // The most recent entry is still there.
+    QueryResult result;
+    EXPECT_TRUE(cache.lookup(0, 499, 0, result));
+}
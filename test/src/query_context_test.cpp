@@ -0,0 +1,82 @@
+#include "query_context.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Context that can skip ahead to any generation instead of running two billion queries.
+ */
+class JumpingContext : public QueryContext
+{
+public:
+    using QueryContext::QueryContext;
+
+    void jumpTo(std::uint32_t stamp) { generation = stamp; }
+};
+
+} // namespace
+
+TEST(QueryContextTest, ResetForgetsThePreviousQuery)
+{
+    QueryContext context(3);
+    context.reach(0, 0.0f, NO_NODE);
+    context.settle(0);
+    context.reach(2, 4.0f, 0);
+    EXPECT_TRUE(context.isSettled(0));
+    EXPECT_TRUE(context.reached(2));
+    EXPECT_FALSE(context.isSettled(2));
+    EXPECT_EQ(context.predecessor(2), 0u);
+
+    context.reset();
+    for (std::uint32_t node = 0; node < 3; ++node)
+    {
+        EXPECT_FALSE(context.reached(node));
+        EXPECT_EQ(context.distance(node), INFINITY_VALUE);
+        EXPECT_EQ(context.predecessor(node), NO_NODE);
+    }
+    EXPECT_TRUE(context.touched().empty());
+}
+
+TEST(QueryContextTest, StampWrapForgetsTheOldQueries)
+{
+    JumpingContext context(2);
+    context.reach(0, 1.0f, NO_NODE);
+    context.settle(0);
+
+    // Last generation before the stamps wrap; node 1 is written in that query.
+    context.jumpTo(std::numeric_limits<std::uint32_t>::max() - 5);
+    context.reset();
+    EXPECT_EQ(context.currentStamp(), std::numeric_limits<std::uint32_t>::max() - 3);
+    context.reach(1, 2.0f, 0);
+    context.settle(1);
+    EXPECT_FALSE(context.reached(0));
+    EXPECT_TRUE(context.isSettled(1));
+
+    // Stamps are cleared and the generation starts over: nothing written before may look current.
+    context.reset();
+    EXPECT_EQ(context.currentStamp(), 2u);
+    EXPECT_FALSE(context.reached(0));
+    EXPECT_FALSE(context.reached(1));
+    EXPECT_EQ(context.distance(1), INFINITY_VALUE);
+    EXPECT_EQ(context.predecessor(1), NO_NODE);
+
+    context.reach(0, 5.0f, NO_NODE);
+    EXPECT_TRUE(context.reached(0));
+    EXPECT_FALSE(context.isSettled(0));
+    EXPECT_EQ(context.distance(0), 5.0f);
+}
+
+TEST(QueryContextTest, DistanceOnlyContextHasNoPredecessors)
+{
+    QueryContext context(2, false);
+    EXPECT_FALSE(context.tracksPredecessors());
+    context.reachDistance(1, 3.0f);
+    EXPECT_EQ(context.distance(1), 3.0f);
+    EXPECT_EQ(context.predecessor(1), NO_NODE);
+}
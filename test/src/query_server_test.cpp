@@ -0,0 +1,194 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "query_server.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+
+/**
+ * @brief Runs servePipe() over temporary files and returns everything it wrote.
+ */
+std::string servePipe(QueryServer &server, const std::string &requests)
+{
+    std::FILE *input = std::tmpfile();
+    std::FILE *output = std::tmpfile();
+    std::fwrite(requests.data(), 1, requests.size(), input);
+    std::fflush(input);
+    std::rewind(input);
+    server.servePipe(fileno(input), fileno(output));
+    std::string result;
+    std::rewind(output);
+    char chunk[4096];
+    std::size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), output)) > 0)
+    {
+        result.append(chunk, got);
+    }
+    std::fclose(input);
+    std::fclose(output);
+    return result;
+}
+
+/**
+ * @brief The answer line the server must give for source -> target.
+ */
+std::string expectedAnswer(CsrDijkstra<> &engine, std::uint32_t source, std::uint32_t target)
+{
+    engine.run(source, target);
+    if (engine.distance(target) == INFINITY_VALUE)
+    {
+        return "unreachable";
+    }
+    char number[32];
+    std::snprintf(number, sizeof(number), "%.9g", static_cast<double>(engine.distance(target)));
+    std::string line = number;
+    std::vector<std::uint32_t> path = engine.path(target);
+    line += ' ' + std::to_string(path.size());
+    for (std::uint32_t node : path)
+    {
+        line += ' ' + std::to_string(node);
+    }
+    return line;
+}
+
+} // namespace
+
+TEST(QueryServerTest, PipeAnswersEveryKindOfLine)
+{
+    const CsrGraph graph = makeGridGraph(10, 10, 4);
+    QueryServer server(graph.view(), ServerOptions());
+    CsrDijkstra<> reference(graph.view());
+
+    std::string output = servePipe(server, "0 99\r\ninfo\n  5\t42 \nhello\n3 1000\n\n17 17\n2 3");
+    std::istringstream lines(output);
+    std::string line;
+    std::vector<std::string> answers;
+    while (std::getline(lines, line))
+    {
+        answers.push_back(line);
+    }
+    ASSERT_EQ(answers.size(), 8u);
+    EXPECT_EQ(answers[0], expectedAnswer(reference, 0, 99));
+    EXPECT_EQ(answers[1], "nodes 100 edges " + std::to_string(graph.view().edgeCount));
+    EXPECT_EQ(answers[2], expectedAnswer(reference, 5, 42));
+    EXPECT_EQ(answers[3], "error expected: <source> <target>");
+    EXPECT_EQ(answers[4], "error node out of range");
+    EXPECT_EQ(answers[5], "error expected: <source> <target>");
+    EXPECT_EQ(answers[6], "0 1 17");
+    EXPECT_EQ(answers[7], expectedAnswer(reference, 2, 3)); // Last line without a newline.
+    EXPECT_EQ(server.stats().requests, 8u);
+}
+
+TEST(QueryServerTest, EveryLineIsCheckedAgainstMaxLine)
+{
+    const CsrGraph graph = makeGridGraph(5, 5, 1);
+    ServerOptions options;
+    options.maxLine = 16;
+    options.withPaths = false;
+    QueryServer server(graph.view(), options);
+
+    // A complete overlong line in the middle of a read ends the conversation there.
+    std::string output = servePipe(server, "0 1\n" + std::string(40, '7') + "\n0 2\n");
+    std::istringstream lines(output);
+    std::string first;
+    std::string second;
+    std::getline(lines, first);
+    std::getline(lines, second);
+    EXPECT_NE(first.find_first_not_of("0123456789."), 0u);
+    EXPECT_EQ(second, "error line too long");
+    EXPECT_TRUE(lines.peek() == std::char_traits<char>::eof());
+}
+
+TEST(QueryServerTest, SocketClientsGetEveryAnswerUnderBackpressure)
+{
+    // A long chain gives cheap queries with answers of about 10 kB, and the output cap is tiny: while the
+    // client is not reading, the socket buffers fill up and the server has to stop reading its requests.
+    const std::uint32_t chainLength = 2000;
+    std::vector<Edge> edges;
+    for (std::uint32_t node = 0; node + 1 < chainLength; ++node)
+    {
+        edges.push_back({node, node + 1, 1.0f});
+    }
+    const CsrGraph graph = buildCsrGraph(chainLength, edges);
+    ServerOptions options;
+    options.threads = 2;
+    options.maxOutput = 4096;
+    QueryServer server(graph.view(), options);
+    const std::string path = ::testing::TempDir() + "query_server_test.sock";
+    std::thread serving([&]() { server.serveSocket(path); });
+
+    int client = -1;
+    for (int attempt = 0; attempt < 500 && client < 0; ++attempt)
+    {
+        client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        if (::connect(client, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            ::close(client);
+            client = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    ASSERT_GE(client, 0);
+
+    const std::uint32_t queryCount = 300;
+    auto sourceOf = [](std::uint32_t i) { return i % 10; };
+    auto targetOf = [&](std::uint32_t i) { return chainLength - 1 - i % 7; };
+    std::string requests;
+    for (std::uint32_t i = 0; i < queryCount; ++i)
+    {
+        requests += std::to_string(sourceOf(i)) + ' ' + std::to_string(targetOf(i)) + '\n';
+    }
+    for (std::size_t sent = 0; sent < requests.size();)
+    {
+        ssize_t written = ::send(client, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+        ASSERT_GT(written, 0);
+        sent += static_cast<std::size_t>(written);
+    }
+    ::shutdown(client, SHUT_WR);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200)); // Let the server run into the cap.
+
+    std::string output;
+    char chunk[65536];
+    ssize_t got;
+    while ((got = ::recv(client, chunk, sizeof(chunk), 0)) > 0)
+    {
+        output.append(chunk, static_cast<std::size_t>(got));
+    }
+    ::close(client);
+    server.stop();
+    serving.join();
+
+    CsrDijkstra<> reference(graph.view());
+    std::istringstream lines(output);
+    std::string line;
+    std::uint32_t index = 0;
+    while (std::getline(lines, line))
+    {
+        ASSERT_LT(index, queryCount);
+        ASSERT_EQ(line, expectedAnswer(reference, sourceOf(index), targetOf(index))) << "answer " << index;
+        index++;
+    }
+    EXPECT_EQ(index, queryCount);
+    EXPECT_GT(output.size(), std::size_t(2) << 20); // Far more than the socket buffers hold.
+    EXPECT_EQ(server.stats().requests, queryCount);
+}
@@ -0,0 +1,131 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "relax_kernels.hpp"
+#include "simd.hpp"
+#include "synthetic_graphs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Vector levels the running CPU supports (empty without AVX2).
+ */
+std::vector<SimdLevel> vectorLevels()
+{
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::Avx2, SimdLevel::Avx512})
+    {
+        if (level <= detectSimdLevel())
+        {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+/**
+ * @brief Dense graph with small integer weights (many ties) and a parallel edge in every row.
+ */
+CsrGraph makeTiedGraph(std::uint32_t nodeCount)
+{
+    std::vector<Edge> edges;
+    for (std::uint32_t from = 0; from < nodeCount; ++from)
+    {
+        for (std::uint32_t to = 0; to < nodeCount; ++to)
+        {
+            if (to != from)
+            {
+                edges.push_back({from, to, static_cast<float>((from * 7 + to * 13) % 5 + 1)});
+            }
+        }
+        edges.push_back({from, (from + 1) % nodeCount, 1.0f});
+    }
+    return buildCsrGraph(nodeCount, edges);
+}
+
+/**
+ * @brief Runs every source with the scalar loop and with each vector kernel and compares the results.
+ */
+void expectSameAsScalar(const CsrGraph &graph, const std::vector<std::uint32_t> &sources)
+{
+    CsrDijkstra<> scalar(graph.view());
+    scalar.setSimdLevel(SimdLevel::Scalar);
+    for (SimdLevel level : vectorLevels())
+    {
+        CsrDijkstra<> kernel(graph.view());
+        kernel.setSimdLevel(level);
+        for (std::uint32_t source : sources)
+        {
+            scalar.run(source);
+            kernel.run(source);
+            ASSERT_EQ(kernel.settledCount(), scalar.settledCount()) << simdLevelName(level);
+            for (std::uint32_t node = 0; node < graph.nodeCount(); ++node)
+            {
+                ASSERT_EQ(kernel.distance(node), scalar.distance(node))
+                    << simdLevelName(level) << ", source " << source << ", node " << node;
+                ASSERT_EQ(kernel.path(node), scalar.path(node))
+                    << simdLevelName(level) << ", source " << source << ", node " << node;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(RelaxKernelsTest, HighDegreeSearchesMatchTheScalarLoop)
+{
+    // 45 edges per row: two or three full blocks plus a scalar tail at either width.
+    const CsrGraph graph = makeRandomGraph(1500, 45, 21);
+    expectSameAsScalar(graph, {0, 733, 1499});
+}
+
+TEST(RelaxKernelsTest, TiedDenseSearchesMatchTheScalarLoop)
+{
+    // Equal candidates and parallel edges inside one block must resolve exactly as the scalar loop does.
+    const CsrGraph graph = makeTiedGraph(150);
+    expectSameAsScalar(graph, {0, 1, 77, 149});
+}
+
+TEST(RelaxKernelsTest, MaskFlagsExactlyTheImprovingEdges)
+{
+    // stamp marks reached nodes and stamp + 1 settled ones; any other stamp means unreached.
+    const std::uint32_t stamp = 5;
+    const std::uint32_t nodeCount = 40;
+    std::vector<float> distances(nodeCount);
+    std::vector<std::uint32_t> stamps(nodeCount);
+    for (std::uint32_t node = 0; node < nodeCount; ++node)
+    {
+        distances[node] = static_cast<float>(node % 9) * 3.0f;
+        stamps[node] = node % 3 == 0 ? stamp : node % 3 == 1 ? stamp + 1 : stamp - 1;
+    }
+    std::vector<std::uint32_t> targets(16);
+    std::vector<float> weights(16);
+    for (std::uint32_t lane = 0; lane < 16; ++lane)
+    {
+        targets[lane] = (lane * 11 + 3) % nodeCount;
+        weights[lane] = static_cast<float>(lane % 4) * 2.5f;
+    }
+    const float base = 6.0f;
+
+    for (SimdLevel level : vectorLevels())
+    {
+        std::uint32_t expected = 0;
+        for (std::uint32_t lane = 0; lane < relaxBlockWidth(level); ++lane)
+        {
+            std::uint32_t node = targets[lane];
+            float current = stamps[node] == stamp ? distances[node] : INFINITY_VALUE;
+            if (stamps[node] != stamp + 1 && base + weights[lane] < current)
+            {
+                expected |= 1u << lane;
+            }
+        }
+        EXPECT_EQ(improvingEdges(level, targets.data(), weights.data(), base, distances.data(), stamps.data(), stamp),
+                  expected)
+            << simdLevelName(level);
+    }
+}
@@ -0,0 +1,125 @@
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "static_graph.hpp"
+#include "test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+// The graph of the examples plus G, which only has outgoing edges: nothing reaches it.
+constexpr StaticEdge EDGES[] = {{'A', 'B', 4.0f}, {'A', 'C', 2.0f}, {'B', 'A', 4.0f}, {'B', 'C', 1.0f},
+                                {'B', 'D', 5.0f}, {'C', 'A', 2.0f}, {'C', 'B', 1.0f}, {'C', 'D', 8.0f},
+                                {'C', 'E', 10.0f}, {'D', 'B', 5.0f}, {'D', 'C', 8.0f}, {'D', 'E', 2.0f},
+                                {'D', 'F', 6.0f}, {'E', 'C', 10.0f}, {'E', 'D', 2.0f}, {'E', 'F', 2.0f},
+                                {'F', 'D', 6.0f}, {'F', 'E', 2.0f}, {'G', 'A', 1.0f}};
+
+constexpr auto GRAPH = makeStaticGraph("ABCDEFG", EDGES);
+constexpr auto TABLE = computeShortestPaths(GRAPH);
+
+constexpr std::uint32_t id(char label) { return GRAPH.idOf(label); }
+
+/**
+ * @brief Path from -> to as labels, evaluated by the compiler through pathInto().
+ */
+constexpr std::array<char, 8> route(char from, char to)
+{
+    std::uint32_t nodes[8]{};
+    std::array<char, 8> labels{};
+    std::size_t length = TABLE.pathInto(id(from), id(to), nodes, 8);
+    for (std::size_t i = 0; i < length && length <= 8; ++i)
+    {
+        labels[i] = GRAPH.labels[nodes[i]];
+    }
+    return labels;
+}
+
+constexpr bool sameRoute(const std::array<char, 8> &found, const char *expected)
+{
+    for (std::size_t i = 0; i < found.size(); ++i)
+    {
+        if (found[i] != expected[i])
+        {
+            return false;
+        }
+        if (expected[i] == '\0')
+        {
+            return true;
+        }
+    }
+    return true;
+}
+
+// Everything below is checked while compiling: a wrong table fails the build, not the test run.
+static_assert(GRAPH.nodeCount() == 7 && GRAPH.edgeCount() == 19, "sizes come from the literals");
+static_assert(GRAPH.idOf('A') == 0 && GRAPH.idOf('G') == 6 && GRAPH.idOf('Z') == NO_NODE, "labels map to ids");
+static_assert(TABLE.distance(id('A'), id('A')) == 0.0f, "a node is at distance 0 from itself");
+static_assert(TABLE.distance(id('A'), id('B')) == 3.0f, "A -> C -> B beats the direct edge");
+static_assert(TABLE.distance(id('A'), id('F')) == 12.0f, "A -> C -> B -> D -> E -> F");
+static_assert(TABLE.distance(id('F'), id('A')) == 12.0f, "F -> E -> D -> B -> C -> A");
+static_assert(TABLE.distance(id('G'), id('F')) == 13.0f, "G leads into the rest of the graph");
+static_assert(TABLE.distance(id('A'), id('G')) == INFINITY_VALUE, "nothing reaches G");
+static_assert(TABLE.distance(id('F'), id('G')) == INFINITY_VALUE, "nothing reaches G");
+static_assert(TABLE.nextHop(id('A'), id('G')) == NO_NODE, "an unreachable target has no next hop");
+static_assert(TABLE.nextHop(id('A'), id('A')) == NO_NODE, "a node has no next hop to itself");
+static_assert(TABLE.nextHop(id('A'), id('F')) == id('C'), "the route to F leaves A through C");
+static_assert(sameRoute(route('A', 'F'), "ACBDEF"), "next hops rebuild the whole route");
+static_assert(sameRoute(route('A', 'G'), ""), "no route to an unreachable node");
+
+} // namespace
+
+TEST(StaticGraphTest, TablesMatchTheRuntimeEngine)
+{
+    std::vector<Edge> edges;
+    for (const StaticEdge &edge : EDGES)
+    {
+        edges.push_back({id(edge.from), id(edge.to), edge.weight});
+    }
+    const CsrGraph graph = buildCsrGraph(GRAPH.nodeCount(), edges);
+    CsrDijkstra<> reference(graph.view());
+    for (std::uint32_t from = 0; from < GRAPH.nodeCount(); ++from)
+    {
+        reference.run(from);
+        for (std::uint32_t to = 0; to < GRAPH.nodeCount(); ++to)
+        {
+            ASSERT_EQ(TABLE.distance(from, to), reference.distance(to)) << from << " -> " << to;
+            std::uint32_t nodes[8];
+            std::size_t length = TABLE.pathInto(from, to, nodes, 8);
+            if (reference.distance(to) == INFINITY_VALUE)
+            {
+                EXPECT_EQ(length, 0u);
+                continue;
+            }
+            ASSERT_GE(length, 1u);
+            ASSERT_LE(length, 8u);
+            EXPECT_EQ(nodes[0], from);
+            EXPECT_EQ(nodes[length - 1], to);
+            std::vector<std::uint32_t> path(nodes, nodes + length);
+            EXPECT_NEAR(pathCost(graph.view(), path), reference.distance(to), sumTolerance(reference.distance(to)));
+        }
+    }
+}
+
+TEST(StaticGraphTest, ViewRunsOnTheCsrEngines)
+{
+    CsrDijkstra<> engine(GRAPH.view());
+    engine.run(id('A'));
+    for (std::uint32_t to = 0; to < GRAPH.nodeCount(); ++to)
+    {
+        EXPECT_EQ(engine.distance(to), TABLE.distance(id('A'), to));
+    }
+}
+
+TEST(StaticGraphTest, ShortBuffersAreLeftUntouched)
+{
+    std::uint32_t nodes[3] = {NO_NODE, NO_NODE, NO_NODE};
+    EXPECT_EQ(TABLE.pathInto(id('A'), id('F'), nodes, 3), 6u);
+    EXPECT_EQ(nodes[0], NO_NODE);
+    EXPECT_EQ(nodes[2], NO_NODE);
+}
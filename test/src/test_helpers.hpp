@@ -0,0 +1,136 @@
+#ifndef TEST_HELPERS_HPP_
+#define TEST_HELPERS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "csr_dijkstra.hpp"
+#include "csr_graph.hpp"
+#include "dijkstra.hpp"
+
+/**
+ * @brief Random directed graph on the labels 'a'... with small integral weights, so that ties are common.
+ */
+inline Dijkstra<>::GraphType randomLabelledGraph(unsigned seed, int nodes, int edges)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    std::uniform_int_distribution<int> cost(0, 4);
+    Dijkstra<>::GraphType graph;
+    for (int node = 0; node < nodes; ++node)
+    {
+        graph[static_cast<char>('a' + node)];
+    }
+    for (int edge = 0; edge < edges; ++edge)
+    {
+        char from = static_cast<char>('a' + pick(random));
+        char to = static_cast<char>('a' + pick(random));
+        graph[from].push_back({to, static_cast<float>(cost(random))});
+    }
+    return graph;
+}
+
+/**
+ * @brief Random graph with dense ids and real-valued weights.
+ */
+inline CsrGraph randomCsrGraph(unsigned seed, std::uint32_t nodes, std::uint32_t edges)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::uint32_t> pick(0, nodes - 1);
+    std::uniform_real_distribution<float> cost(0.0f, 10.0f);
+    std::vector<Edge> list;
+    for (std::uint32_t edge = 0; edge < edges; ++edge)
+    {
+        std::uint32_t from = pick(random);
+        std::uint32_t to = pick(random);
+        list.push_back({from, to, cost(random)});
+    }
+    return buildCsrGraph(nodes, list);
+}
+
+/**
+ * @brief Length of a node sequence walked edge by edge (cheapest parallel edge), added up from the front.
+ *
+ * @return The length, or -1 if two consecutive nodes are not joined by an edge.
+ */
+inline float pathCost(CsrView g, const std::vector<std::uint32_t> &path)
+{
+    float total = 0.0f;
+    for (std::size_t i = 0; i + 1 < path.size(); ++i)
+    {
+        float cheapest = INFINITY_VALUE;
+        for (std::uint32_t edge = g.firstEdge(path[i]); edge < g.lastEdge(path[i]); ++edge)
+        {
+            if (g.targets[edge] == path[i + 1])
+            {
+                cheapest = std::min(cheapest, g.weights[edge]);
+            }
+        }
+        if (cheapest == INFINITY_VALUE)
+        {
+            return -1.0f;
+        }
+        total += cheapest;
+    }
+    return total;
+}
+
+/**
+ * @brief Tolerance for comparing distances added up in a different order (e.g. from both ends).
+ */
+inline float sumTolerance(float distance)
+{
+    return 1e-5f * std::max(distance, 1.0f);
+}
+
+/**
+ * @brief Runs queries from a few sources to every node and checks distances and paths against CsrDijkstra.
+ *
+ * @param graph Graph the engine under test searches.
+ * @param runQuery Callable as float runQuery(source, target): answers one query.
+ * @param getPath Callable as std::vector<std::uint32_t> getPath(target): path of the query just answered,
+ *                source first, empty if target is unreachable.
+ * @param sourceStep Gap between the sources tried (0, sourceStep, 2 * sourceStep...).
+ * @param exact Compare distances to within 4 ULPs (same summation order as Dijkstra) instead of sumTolerance().
+ */
+template <typename RunQuery, typename GetPath>
+void expectMatchesDijkstra(const CsrGraph &graph, RunQuery runQuery, GetPath getPath, std::uint32_t sourceStep,
+                           bool exact = false)
+{
+    CsrDijkstra<> reference(graph.view());
+    for (std::uint32_t source = 0; source < graph.nodeCount(); source += sourceStep)
+    {
+        reference.run(source);
+        for (std::uint32_t target = 0; target < graph.nodeCount(); ++target)
+        {
+            float expected = reference.distance(target);
+            float found = runQuery(source, target);
+            if (expected == INFINITY_VALUE)
+            {
+                EXPECT_EQ(found, INFINITY_VALUE) << source << " -> " << target;
+                EXPECT_TRUE(getPath(target).empty());
+                continue;
+            }
+            if (exact)
+            {
+                ASSERT_FLOAT_EQ(found, expected) << source << " -> " << target;
+            }
+            else
+            {
+                ASSERT_NEAR(found, expected, sumTolerance(expected)) << source << " -> " << target;
+            }
+            std::vector<std::uint32_t> path = getPath(target);
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(path.front(), source);
+            EXPECT_EQ(path.back(), target);
+            EXPECT_NEAR(pathCost(graph.view(), path), expected, sumTolerance(expected)) << source << " -> " << target;
+        }
+    }
+}
+
+#endif // TEST_HELPERS_HPP_
@@ -0,0 +1,55 @@
+#include "dijkstra.hpp"
+#include "tracing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+
+TEST(EventLogTraceTest, KeepsTheLastEventsOldestFirst)
+{
+    EventLogTrace<4> log;
+    for (std::uint32_t node = 0; node < 10; ++node)
+    {
+        log.iteration(node + 1, node);
+    }
+
+    EXPECT_EQ(log.recorded(), 10u);
+    ASSERT_EQ(log.size(), 4u);
+    for (std::size_t i = 0; i < log.size(); ++i)
+    {
+        EXPECT_EQ(log[i].kind, TraceEvent::ITERATION);
+        EXPECT_EQ(log[i].node, 6 + i);
+        EXPECT_EQ(log[i].from, 7 + i);
+    }
+
+    log.clear();
+    EXPECT_EQ(log.size(), 0u);
+    log.reachedTarget('F');
+    ASSERT_EQ(log.size(), 1u);
+    EXPECT_EQ(log[0].node, static_cast<std::uint32_t>('F'));
+}
+
+TEST(EventLogTraceTest, DumpsOneLinePerEvent)
+{
+    EventLogTrace<8> log;
+    log.pop(3u, 1.5f);
+    log.relax(3u, 4u, 2.5f);
+    std::ostringstream out;
+    log.dump(out);
+    EXPECT_EQ(out.str(), "pop node=3 from=0 value=1.5\nrelax node=4 from=3 value=2.5\n");
+}
+
+TEST(CountingTraceTest, CountsTheWorkOfASearch)
+{
+    Dijkstra<>::GraphType graph = {{'A', {{'B', 1.0f}, {'C', 4.0f}}}, {'B', {{'C', 1.0f}}}, {'C', {}}};
+    Dijkstra<BinaryHeap, CountingTrace> dijkstra(Point('A', 0.0f), Point('#', 0.0f), graph);
+    dijkstra.initializeDistances();
+    dijkstra.calculateDistances();
+
+    const CountingTrace &counts = dijkstra.tracer();
+    EXPECT_EQ(counts.iterations, 3u);
+    EXPECT_EQ(counts.relaxations, 3u);
+    EXPECT_EQ(counts.decreases, 3u); // C is improved twice: 4 from A, then 2 through B.
+    EXPECT_EQ(counts.pops, 3u);
+}
@@ -0,0 +1,172 @@
+#include "dijkstra.hpp"
+#include "indexed_heap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Random directed graph on the labels 'a'... with integer weights in [0, maxWeight].
+ */
+template <typename Weight>
+typename Dijkstra<LinearScan, NoTrace, Weight>::GraphType randomGraph(unsigned seed, int nodes, int edges,
+                                                                    std::uint64_t maxWeight)
+{
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    std::uniform_int_distribution<std::uint64_t> cost(0, maxWeight);
+    typename Dijkstra<LinearScan, NoTrace, Weight>::GraphType graph;
+    for (int node = 0; node < nodes; ++node)
+    {
+        graph[static_cast<char>('a' + node)];
+    }
+    for (int edge = 0; edge < edges; ++edge)
+    {
+        char from = static_cast<char>('a' + pick(random));
+        char to = static_cast<char>('a' + pick(random));
+        graph[from].push_back({to, static_cast<Weight>(cost(random))});
+    }
+    return graph;
+}
+
+/**
+ * @brief Distance from 'a' to every other node, one search per target (a search stops at its target).
+ */
+template <typename Frontier, typename Weight>
+std::vector<std::string> distancesFrom(const typename Dijkstra<LinearScan, NoTrace, Weight>::GraphType &graph)
+{
+    std::vector<std::string> result;
+    for (const auto &node : graph)
+    {
+        Dijkstra<Frontier, NoTrace, Weight> engine({'a', 0}, {node.first, 0}, graph);
+        engine.initializeDistances();
+        engine.calculateDistances();
+        std::ostringstream out;
+        engine.displayDistances(out);
+        std::string text = out.str();
+        std::string line = std::string("Node: ") + node.first + ", Distance: ";
+        std::size_t start = text.find(line) + line.size();
+        result.push_back(text.substr(start, text.find('\n', start) - start));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(WeightTypesTest, BucketQueueIsOnlyPickedForSmallWeights)
+{
+    static_assert(std::is_same<FrontierFor<AutoFrontier, std::uint16_t>, BucketQueue<std::uint16_t>>::value, "");
+    static_assert(std::is_same<FrontierFor<AutoFrontier, std::uint32_t>, IndexedDaryHeap<2, std::uint32_t>>::value,
+                  "");
+    static_assert(std::is_same<FrontierFor<AutoFrontier, float>, IndexedDaryHeap<2, float>>::value, "");
+    static_assert(std::is_same<FrontierFor<SmallWeight<>, std::uint32_t>, BucketQueue<std::uint32_t>>::value, "");
+    static_assert(std::is_same<FrontierFor<SmallWeight<>, double>, IndexedDaryHeap<2, double>>::value, "");
+    static_assert(std::is_same<FrontierFor<BinaryHeap, std::uint64_t>, IndexedDaryHeap<2, std::uint64_t>>::value,
+                  "");
+    static_assert(std::is_same<FrontierFor<LazyHeap, double>, LazyBinaryHeap<double>>::value, "");
+}
+
+TEST(WeightTypesTest, IntegerFrontiersMatchTheLinearScan)
+{
+    for (unsigned seed = 1; seed <= 20; ++seed)
+    {
+        for (std::uint64_t maxWeight : {2u, 4999u})
+        {
+            auto graph = randomGraph<std::uint32_t>(seed, 24, 90, maxWeight);
+            std::vector<std::string> expected = distancesFrom<LinearScan, std::uint32_t>(graph);
+            EXPECT_EQ((distancesFrom<SmallWeight<4999>, std::uint32_t>(graph)), expected) << "seed " << seed;
+            EXPECT_EQ((distancesFrom<AutoFrontier, std::uint32_t>(graph)), expected) << "seed " << seed;
+            EXPECT_EQ((distancesFrom<BinaryHeap, std::uint32_t>(graph)), expected) << "seed " << seed;
+        }
+    }
+}
+
+TEST(WeightTypesTest, LargeIntegerWeightsUseTheHeap)
+{
+    // Costs around 10^9 would need a ring of 2^30 buckets; AutoFrontier gives them the heap instead.
+    for (unsigned seed = 1; seed <= 5; ++seed)
+    {
+        auto graph = randomGraph<std::uint32_t>(seed, 20, 60, 1000000000u);
+        std::vector<std::string> expected = distancesFrom<LinearScan, std::uint32_t>(graph);
+        EXPECT_EQ((distancesFrom<AutoFrontier, std::uint32_t>(graph)), expected) << "seed " << seed;
+    }
+}
+
+TEST(WeightTypesTest, BucketQueueRefusesSpansAboveItsCap)
+{
+    BucketQueue<std::uint32_t> queue;
+    queue.push(0, 0);
+    queue.push(1, static_cast<std::uint32_t>(BucketQueue<>::MAX_SPAN - 1));
+    EXPECT_THROW(queue.push(2, static_cast<std::uint32_t>(BucketQueue<>::MAX_SPAN)), std::length_error);
+    EXPECT_THROW(queue.push(3, 1000000000u), std::length_error);
+
+    // A 64-bit span of 2^63 or more used to overflow the doubling and loop forever.
+    BucketQueue<std::uint64_t> wide;
+    wide.push(0, 0);
+    EXPECT_THROW(wide.push(1, std::uint64_t(1) << 63), std::length_error);
+    EXPECT_THROW(wide.push(1, ~std::uint64_t(0)), std::length_error);
+    std::uint32_t id;
+    std::uint64_t key;
+    ASSERT_TRUE(wide.pop(id, key));
+    EXPECT_EQ(key, 0u);
+    EXPECT_TRUE(wide.empty());
+}
+
+TEST(WeightTypesTest, WideIntegersStayExact)
+{
+    // Weights around 2^40 lose their low bits in a float; 64-bit integers and the lazy heap keep them.
+    for (unsigned seed = 1; seed <= 10; ++seed)
+    {
+        auto graph = randomGraph<std::uint64_t>(seed, 20, 70, std::uint64_t(1) << 40);
+        std::vector<std::string> expected = distancesFrom<LinearScan, std::uint64_t>(graph);
+        EXPECT_EQ((distancesFrom<QuaternaryHeap, std::uint64_t>(graph)), expected) << "seed " << seed;
+        EXPECT_EQ((distancesFrom<LazyHeap, std::uint64_t>(graph)), expected) << "seed " << seed;
+    }
+}
+
+TEST(WeightTypesTest, BucketQueuePopsInKeyOrder)
+{
+    BucketQueue<std::uint32_t> queue;
+    std::mt19937 random(3);
+    std::uniform_int_distribution<std::uint32_t> step(0, 300); // Spans wider than the ring make it grow.
+    std::uint32_t last = 0;
+    queue.push(0, 0);
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::uint32_t id;
+        std::uint32_t key;
+        if (queue.pop(id, key))
+        {
+            ASSERT_GE(key, last);
+            last = key;
+        }
+        queue.push(static_cast<std::uint32_t>(round), last + step(random));
+        queue.push(static_cast<std::uint32_t>(round), last + step(random));
+    }
+    std::uint32_t id;
+    std::uint32_t key;
+    while (queue.pop(id, key))
+    {
+        ASSERT_GE(key, last);
+        last = key;
+    }
+    EXPECT_TRUE(queue.empty());
+
+    // After clear() the first key pushed may be smaller than anything seen before.
+    queue.push(1, last + 10);
+    queue.clear();
+    queue.push(2, 7);
+    ASSERT_TRUE(queue.pop(id, key));
+    EXPECT_EQ(id, 2u);
+    EXPECT_EQ(key, 7u);
+}